@@ -0,0 +1,315 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "BoltzmannCooling.h"
+#include "CauchyCooling.h"
+#include "ConstantCooling.h"
+#include "GeometricCooling.h"
+#include "HuangCooling.h"
+#include "LamDelosmeCooling.h"
+#include "LogarithmicCooling.h"
+#include "RandomGenerator.h"
+#include "ScheduleMutation.h"
+#include "ScheduleSolution.h"
+#include "SimulatedAnnealing.h"
+#include "SolutionGenerator.h"
+
+// Счётчик выделений памяти: глобальный operator new заменён только в этой программе
+static std::uint64_t allocationCount = 0;
+
+void* operator new(std::size_t size) {
+    ++allocationCount;
+    if (void* pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+namespace {
+
+// Не даёт компилятору выбросить вычисление, результат которого не используется
+template <typename Value>
+void keep(const Value& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+struct BenchmarkResult {
+    std::string name;
+    int jobCount;
+    int processorCount;
+    std::uint64_t operations;
+    double nanosecondsPerOperation;
+    double allocationsPerOperation;
+};
+
+struct BenchmarkOptions {
+    std::vector<int> jobCounts = {100, 1000, 10000, 100000};
+    std::vector<int> processorCounts = {2, 8, 64};
+    double minSeconds = 0.2;
+    std::string filter;
+    std::string outputPath;
+};
+
+std::vector<int> parseList(const std::string& text) {
+    std::vector<int> values;
+    std::stringstream stream(text);
+    std::string token;
+    while (std::getline(stream, token, ',')) {
+        values.push_back(std::stoi(token));
+        if (values.back() <= 0) {
+            throw std::invalid_argument("List values must be positive: " + text);
+        }
+    }
+    return values;
+}
+
+}
+
+// Измеряет шаги горячего цикла по отдельности на сетке размеров задачи.
+// Друг SimulatedAnnealing и ScheduleMutation: часть шагов - закрытые методы
+class HotPathBenchmark {
+public:
+    explicit HotPathBenchmark(const BenchmarkOptions& options)
+        : options_(options) {
+    }
+
+    std::vector<BenchmarkResult> runAll() {
+        for (int jobCount : options_.jobCounts) {
+            for (int processorCount : options_.processorCounts) {
+                runSolutionBenchmarks(jobCount, processorCount);
+            }
+        }
+        runAcceptanceBenchmark();
+        runCoolingBenchmarks();
+        return results_;
+    }
+
+private:
+    static constexpr int kBatchCandidates = 16;
+
+    const BenchmarkOptions& options_;
+    std::vector<BenchmarkResult> results_;
+
+    // Удваивает число операций, пока замер не займёт minSeconds; выделения считаются в последнем замере
+    template <typename Operation>
+    void measure(const std::string& name, int jobCount, int processorCount, Operation&& operation) {
+        if (!options_.filter.empty() && name.find(options_.filter) == std::string::npos) {
+            return;
+        }
+
+        std::uint64_t operations = 1;
+        while (true) {
+            std::uint64_t allocationsBefore = allocationCount;
+            auto start = std::chrono::steady_clock::now();
+            for (std::uint64_t i = 0; i < operations; ++i) {
+                operation();
+            }
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::uint64_t allocations = allocationCount - allocationsBefore;
+
+            if (seconds >= options_.minSeconds || operations >= (std::uint64_t(1) << 40)) {
+                results_.push_back({name, jobCount, processorCount, operations,
+                                    seconds * 1e9 / static_cast<double>(operations),
+                                    static_cast<double>(allocations) / static_cast<double>(operations)});
+                std::cerr << name << " jobs=" << jobCount << " processors=" << processorCount << ": "
+                          << results_.back().nanosecondsPerOperation << " ns/op" << std::endl;
+                return;
+            }
+            operations *= 2;
+        }
+    }
+
+    void runSolutionBenchmarks(int jobCount, int processorCount) {
+        RandomGenerator random(RandomGenerator::deriveSeed(1, static_cast<std::uint64_t>(jobCount) * 1000 + processorCount));
+        std::vector<double> durations(jobCount);
+        for (double& duration : durations) {
+            duration = 1.0 + 99.0 * random.nextDouble();
+        }
+        auto solution = SolutionGenerator::generateRandomSolution(jobCount, processorCount, durations, random());
+
+        ScheduleMutation mutation;
+        mutation.setSeed(random());
+
+        measure("evaluate", jobCount, processorCount, [&]() {
+            keep(solution->evaluate());
+        });
+        measure("clone", jobCount, processorCount, [&]() {
+            keep(solution->clone());
+        });
+        measure("copy_constructor", jobCount, processorCount, [&]() {
+            ScheduleSolution copy(*solution);
+            keep(copy);
+        });
+        measure("apply_move_operation", jobCount, processorCount, [&]() {
+            keep(mutation.applyMoveOperation(solution));
+        });
+        measure("apply_swap_operation", jobCount, processorCount, [&]() {
+            keep(mutation.applySwapOperation(solution));
+        });
+        // Выбор пары работ для обмена измеряется через предложение, в котором остаются только обмены
+        ScheduleMutation swapMutation;
+        swapMutation.setSeed(random());
+        swapMutation.setSwapProbability(1.0);
+        measure("propose_swap", jobCount, processorCount, [&]() {
+            keep(swapMutation.propose(*solution));
+        });
+        // Для сравнения с копирующими операциями: полный шаг протокола без копирования
+        measure("propose_evaluate_apply_move", jobCount, processorCount, [&]() {
+            SolutionMove move = mutation.propose(*solution);
+            keep(solution->evaluateMove(move));
+            solution->applyMove(move);
+        });
+        // Одиночные и пакетные предложения на одинаковом числе кандидатов, без применения
+        std::vector<SolutionMove> moves(kBatchCandidates);
+        std::vector<double> deltas(kBatchCandidates);
+        measure("propose_evaluate_single_x16", jobCount, processorCount, [&]() {
+            for (int i = 0; i < kBatchCandidates; ++i) {
+                deltas[i] = solution->evaluateMove(mutation.propose(*solution));
+            }
+            keep(deltas);
+        });
+        measure("propose_evaluate_batch_x16", jobCount, processorCount, [&]() {
+            mutation.proposeBatch(*solution, moves.data(), kBatchCandidates);
+            solution->evaluateMoves(moves.data(), kBatchCandidates, deltas.data());
+            keep(deltas);
+        });
+    }
+
+    void runAcceptanceBenchmark() {
+        SimulatedAnnealing algorithm;
+        algorithm.setSeed(2);
+        algorithm.setInitialTemperature(10.0);
+
+        // Смесь улучшений и ухудшений порядка температуры, как в середине прогона
+        RandomGenerator random(3);
+        std::vector<double> deltas(4096);
+        for (double& delta : deltas) {
+            delta = 40.0 * random.nextDouble() - 10.0;
+        }
+
+        size_t index = 0;
+        measure("should_accept_solution", 0, 0, [&]() {
+            keep(algorithm.shouldAcceptSolution(deltas[index++ & (deltas.size() - 1)]));
+        });
+    }
+
+    void runCoolingBenchmarks() {
+        std::vector<std::pair<std::string, std::shared_ptr<ICoolingLaw>>> laws = {
+            {"cool_boltzmann", std::make_shared<BoltzmannCooling>()},
+            {"cool_cauchy", std::make_shared<CauchyCooling>()},
+            {"cool_logarithmic", std::make_shared<LogarithmicCooling>()},
+            {"cool_constant", std::make_shared<ConstantCooling>()},
+        };
+        for (auto& [name, law] : laws) {
+            law->initialize(1000.0);
+            int iteration = 0;
+            measure(name, 0, 0, [&]() {
+                keep(law->cool(++iteration));
+                if (iteration == 1 << 30) {
+                    iteration = 0;
+                }
+            });
+        }
+
+        // Адаптивные законы работают через update(): обратная связь фиксирована и типична для
+        // середины прогона, а температура периодически сбрасывается, чтобы не уйти в денормализованные числа
+        CoolingFeedback feedback;
+        feedback.temperature = 1000.0;
+        feedback.proposals = 1000;
+        feedback.accepts = 440;
+        feedback.meanDelta = 5.0;
+        feedback.deltaVariance = 400.0;
+        feedback.meanFitness = 5000.0;
+        feedback.fitnessVariance = 2500.0;
+        feedback.currentFitness = 5000.0;
+        feedback.bestFitness = 4900.0;
+        feedback.stepsWithoutImprovement = 1;
+
+        std::vector<std::pair<std::string, std::shared_ptr<ICoolingLaw>>> adaptiveLaws = {
+            {"update_geometric", std::make_shared<GeometricCooling>()},
+            {"update_lam_delosme", std::make_shared<LamDelosmeCooling>()},
+            {"update_huang", std::make_shared<HuangCooling>()},
+        };
+        for (auto& [name, law] : adaptiveLaws) {
+            law->initialize(1000.0);
+            int iteration = 0;
+            measure(name, 0, 0, [&]() {
+                keep(law->update(++iteration, feedback));
+                if ((iteration & 1023) == 0) {
+                    law->initialize(1000.0);
+                }
+            });
+        }
+    }
+};
+
+void printUsage(const std::string& programName) {
+    std::cout << "Usage: " << programName << " [--jobs <n1,n2,...>] [--processors <m1,m2,...>] [--min-time <ms>] [--filter <substring>] [--output <file.csv>]" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        BenchmarkOptions options;
+        for (int i = 1; i < argc; ++i) {
+            std::string option = argv[i];
+            if (option == "--jobs" && i + 1 < argc) {
+                options.jobCounts = parseList(argv[++i]);
+            } else if (option == "--processors" && i + 1 < argc) {
+                options.processorCounts = parseList(argv[++i]);
+            } else if (option == "--min-time" && i + 1 < argc) {
+                options.minSeconds = std::stod(argv[++i]) / 1000.0;
+            } else if (option == "--filter" && i + 1 < argc) {
+                options.filter = argv[++i];
+            } else if (option == "--output" && i + 1 < argc) {
+                options.outputPath = argv[++i];
+            } else {
+                throw std::invalid_argument("Unknown option: " + option);
+            }
+        }
+
+        HotPathBenchmark benchmark(options);
+        auto results = benchmark.runAll();
+
+        std::ofstream file;
+        if (!options.outputPath.empty()) {
+            file.open(options.outputPath);
+            if (!file.is_open()) {
+                throw std::runtime_error("Cannot open file: " + options.outputPath);
+            }
+        }
+        std::ostream& output = options.outputPath.empty() ? std::cout : file;
+
+        output << "benchmark,job_count,processor_count,operations,ns_per_op,allocs_per_op\n";
+        for (const auto& result : results) {
+            output << result.name << ',' << result.jobCount << ',' << result.processorCount << ','
+                   << result.operations << ',' << result.nanosecondsPerOperation << ','
+                   << result.allocationsPerOperation << '\n';
+        }
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        printUsage(argv[0]);
+        return 1;
+    }
+}
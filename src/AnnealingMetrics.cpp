@@ -0,0 +1,69 @@
+#include "AnnealingMetrics.h"
+#include <sstream>
+
+void AnnealingMetrics::add(const AnnealingMetrics& other) {
+    proposals += other.proposals;
+    accepts += other.accepts;
+    uphillAccepts += other.uphillAccepts;
+    improvements += other.improvements;
+    temperatureSteps += other.temperatureSteps;
+    reheats += other.reheats;
+    eliteRestarts += other.eliteRestarts;
+    kicks += other.kicks;
+    runSeconds += other.runSeconds;
+}
+
+double AnnealingMetrics::iterationsPerSecond() const {
+    return runSeconds > 0.0 ? proposals / runSeconds : 0.0;
+}
+
+double AnnealingMetrics::acceptanceRate() const {
+    return proposals > 0 ? static_cast<double>(accepts) / proposals : 0.0;
+}
+
+std::string AnnealingMetrics::toJson() const {
+    std::ostringstream json;
+    json << "{\"proposals\":" << proposals
+         << ",\"accepts\":" << accepts
+         << ",\"uphill_accepts\":" << uphillAccepts
+         << ",\"improvements\":" << improvements
+         << ",\"temperature_steps\":" << temperatureSteps
+         << ",\"reheats\":" << reheats
+         << ",\"elite_restarts\":" << eliteRestarts
+         << ",\"kicks\":" << kicks
+         << ",\"run_seconds\":" << runSeconds
+         << ",\"iterations_per_second\":" << iterationsPerSecond()
+         << ",\"acceptance_rate\":" << acceptanceRate()
+         << "}";
+    return json.str();
+}
+
+double ParallelMetrics::iterationsPerSecond() const {
+    return wallSeconds > 0.0 ? total.proposals / wallSeconds : 0.0;
+}
+
+std::string ParallelMetrics::toJson() const {
+    std::ostringstream json;
+    json << "{\"wall_seconds\":" << wallSeconds
+         << ",\"iterations_per_second\":" << iterationsPerSecond()
+         << ",\"exchanges\":" << exchanges
+         << ",\"global_improvements\":" << globalImprovements
+         << ",\"snapshot_publishes\":" << snapshotPublishes
+         << ",\"snapshot_imports\":" << snapshotImports
+         << ",\"migrations_sent\":" << migrationsSent
+         << ",\"migrations_accepted\":" << migrationsAccepted
+         << ",\"migrations_dropped\":" << migrationsDropped
+         << ",\"swap_attempts\":" << swapAttempts
+         << ",\"swap_accepts\":" << swapAccepts
+         << ",\"temperatures\":[";
+    for (size_t i = 0; i < temperatures.size(); ++i) {
+        json << (i > 0 ? "," : "") << temperatures[i];
+    }
+    json << "],\"total\":" << total.toJson()
+         << ",\"threads\":[";
+    for (size_t i = 0; i < threads.size(); ++i) {
+        json << (i > 0 ? "," : "") << threads[i].toJson();
+    }
+    json << "]}";
+    return json.str();
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Снимок счётчиков одного экземпляра SimulatedAnnealing (накапливаются по всем запускам run())
+struct AnnealingMetrics {
+    std::uint64_t proposals = 0;
+    std::uint64_t accepts = 0;
+    std::uint64_t uphillAccepts = 0;
+    std::uint64_t improvements = 0;
+    std::uint64_t temperatureSteps = 0;
+    // Реакции на застой по стратегиям
+    std::uint64_t reheats = 0;
+    std::uint64_t eliteRestarts = 0;
+    std::uint64_t kicks = 0;
+    double runSeconds = 0.0;
+
+    void add(const AnnealingMetrics& other);
+    double iterationsPerSecond() const;
+    double acceptanceRate() const;
+    std::string toJson() const;
+};
+
+// Снимок счётчиков ParallelSimulatedAnnealing: по потокам, суммарно и по обменам
+struct ParallelMetrics {
+    std::vector<AnnealingMetrics> threads;
+    AnnealingMetrics total;
+    std::uint64_t exchanges = 0;
+    std::uint64_t globalImprovements = 0;
+    std::uint64_t snapshotPublishes = 0;
+    std::uint64_t snapshotImports = 0;
+    // Только для островной модели
+    std::uint64_t migrationsSent = 0;
+    std::uint64_t migrationsAccepted = 0;
+    std::uint64_t migrationsDropped = 0;
+    // Только для параллельного отжига с обменом реплик
+    std::uint64_t swapAttempts = 0;
+    std::uint64_t swapAccepts = 0;
+    std::vector<double> temperatures;
+    double wallSeconds = 0.0;
+
+    double iterationsPerSecond() const;
+    std::string toJson() const;
+};
@@ -0,0 +1,233 @@
+#include "BatchSolver.h"
+#include "Logger.h"
+#include "RandomGenerator.h"
+#include "ScheduleMutation.h"
+#include "SimulatedAnnealing.h"
+#include "SolutionGenerator.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+// Поле CSV в кавычках, если в нём есть разделитель, кавычка или перевод строки
+std::string quoteCsv(const std::string& field) {
+    if (field.find_first_of(",\"\r\n") == std::string::npos) {
+        return field;
+    }
+    std::string quoted = "\"";
+    for (char c : field) {
+        if (c == '"') {
+            quoted += '"';
+        }
+        quoted += c;
+    }
+    quoted += '"';
+    return quoted;
+}
+
+}
+
+BatchSolver::BatchSolver(int threadCount)
+    : threadCount_(threadCount)
+    , initialTemperature_(1000.0)
+    , iterationsPerTemperature_(1000)
+    , maxIterationsWithoutImprovement_(100)
+    , restarts_(1)
+    , seed_(RandomGenerator::clockSeed()) {
+}
+
+void BatchSolver::setCoolingLawFactory(CoolingLawFactory factory) {
+    coolingLawFactory_ = std::move(factory);
+}
+
+void BatchSolver::setInitialTemperature(double temperature) {
+    initialTemperature_ = temperature;
+}
+
+void BatchSolver::setIterationsPerTemperature(int iterations) {
+    iterationsPerTemperature_ = iterations;
+}
+
+void BatchSolver::setMaxIterationsWithoutImprovement(int iterations) {
+    maxIterationsWithoutImprovement_ = iterations;
+}
+
+void BatchSolver::setRestarts(int restarts) {
+    if (restarts <= 0) {
+        throw std::invalid_argument("Restart count must be positive");
+    }
+    restarts_ = restarts;
+}
+
+void BatchSolver::setSeed(std::uint64_t seed) {
+    seed_ = seed;
+}
+
+std::vector<std::string> BatchSolver::collectInstances(const std::string& path) {
+    namespace fs = std::filesystem;
+    std::vector<std::string> instances;
+
+    if (fs::is_directory(path)) {
+        for (const auto& entry : fs::directory_iterator(path)) {
+            if (entry.is_regular_file() && (entry.path().extension() == ".csv" || entry.path().extension() == ".bin")) {
+                instances.push_back(entry.path().string());
+            }
+        }
+        std::sort(instances.begin(), instances.end());
+        return instances;
+    }
+
+    std::ifstream manifest(path);
+    if (!manifest.is_open()) {
+        throw std::runtime_error("Cannot open manifest: " + path);
+    }
+
+    fs::path baseDirectory = fs::path(path).parent_path();
+    std::string line;
+    while (std::getline(manifest, line)) {
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        fs::path instancePath(line);
+        instances.push_back(instancePath.is_absolute() ? line : (baseDirectory / instancePath).string());
+    }
+    return instances;
+}
+
+int BatchSolver::solve(const std::vector<std::string>& instancePaths, const std::string& outputPath) {
+    if (!coolingLawFactory_) {
+        throw std::logic_error("Cooling law factory is not set");
+    }
+
+    std::vector<std::unique_ptr<InstanceResult>> results;
+    results.reserve(instancePaths.size());
+    for (const auto& path : instancePaths) {
+        results.push_back(std::make_unique<InstanceResult>());
+        results.back()->path = path;
+    }
+
+    LOG_INFO("Batch STARTED: instances=" + std::to_string(instancePaths.size()) +
+             ", restarts=" + std::to_string(restarts_) + ", threads=" + std::to_string(threadCount_));
+
+    {
+        WorkStealingPool pool(threadCount_);
+
+        for (size_t i = 0; i < results.size(); ++i) {
+            // Зерно задачи зависит только от её номера, поэтому результат не зависит от порядка выполнения
+            std::uint64_t instanceSeed = RandomGenerator::deriveSeed(seed_, i);
+            InstanceResult* result = results[i].get();
+
+            pool.submit([this, &pool, result, instanceSeed]() {
+                result->start = std::chrono::steady_clock::now();
+                try {
+                    result->data = IDataReader::createForPath(result->path)->readData(result->path);
+                    result->loaded = true;
+                } catch (const std::exception& e) {
+                    result->error = e.what();
+                    result->end = std::chrono::steady_clock::now();
+                    return;
+                }
+
+                // Перезапуски ставятся в деку этого потока: он продолжит с ними, пока данные
+                // задачи в кэше, а свободные потоки заберут часть перезапусков себе
+                result->bestFitness = std::numeric_limits<double>::max();
+                for (int restart = 0; restart < restarts_; ++restart) {
+                    pool.submit([this, result, instanceSeed, restart]() {
+                        try {
+                            solveRestart(*result, instanceSeed, restart);
+                        } catch (const std::exception& e) {
+                            LOG_INFO("Batch restart FAILED: " + result->path + ", restart=" +
+                                     std::to_string(restart) + ": " + e.what());
+                            std::lock_guard<std::mutex> lock(result->mutex);
+                            result->error = e.what();
+                            finishRestart(*result);
+                        }
+                    });
+                }
+            });
+        }
+
+        pool.wait();
+        LOG_INFO("Batch pool finished, steals=" + std::to_string(pool.stealCount()));
+    }
+
+    writeResults(results, outputPath);
+
+    int solved = 0;
+    for (const auto& result : results) {
+        if (result->loaded && result->finishedRestarts > 0) {
+            ++solved;
+            if (result->finishedRestarts < result->completedRestarts) {
+                std::cerr << "Instance partially failed: " << result->path << ": "
+                          << result->completedRestarts - result->finishedRestarts << " of "
+                          << result->completedRestarts << " restarts failed: " << result->error << std::endl;
+            }
+        } else {
+            std::cerr << "Instance failed: " << result->path << ": " << result->error << std::endl;
+        }
+    }
+
+    LOG_INFO("Batch FINISHED: solved=" + std::to_string(solved) + "/" + std::to_string(results.size()));
+    return solved;
+}
+
+void BatchSolver::solveRestart(InstanceResult& result, std::uint64_t instanceSeed, int restart) {
+    const InputData& data = result.data;
+    std::uint64_t stream = 3 * static_cast<std::uint64_t>(restart);
+
+    auto mutation = std::make_shared<ScheduleMutation>();
+    mutation->setSeed(RandomGenerator::deriveSeed(instanceSeed, stream));
+
+    SimulatedAnnealing algorithm;
+    algorithm.setSeed(RandomGenerator::deriveSeed(instanceSeed, stream + 1));
+    algorithm.setInitialSolution(SolutionGenerator::generateRandomSolution(
+        data.jobCount, data.processorCount, data.jobDurations, RandomGenerator::deriveSeed(instanceSeed, stream + 2)));
+    algorithm.setMutation(mutation);
+    algorithm.setCoolingLaw(coolingLawFactory_());
+    algorithm.setInitialTemperature(initialTemperature_);
+    algorithm.setIterationsPerTemperature(iterationsPerTemperature_);
+    algorithm.setMaxIterationsWithoutImprovement(maxIterationsWithoutImprovement_);
+    algorithm.run();
+
+    double fitness = algorithm.getBestFitness();
+
+    std::lock_guard<std::mutex> lock(result.mutex);
+    result.bestFitness = std::min(result.bestFitness, fitness);
+    result.fitnessSum += fitness;
+    ++result.finishedRestarts;
+    finishRestart(result);
+}
+
+void BatchSolver::finishRestart(InstanceResult& result) {
+    if (++result.completedRestarts == restarts_) {
+        result.end = std::chrono::steady_clock::now();
+    }
+}
+
+void BatchSolver::writeResults(const std::vector<std::unique_ptr<InstanceResult>>& results, const std::string& outputPath) {
+    std::ofstream file(outputPath);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file: " + outputPath);
+    }
+
+    file << "instance,job_count,processor_count,restarts,best_fitness,mean_fitness,seconds,status\n";
+    for (const auto& result : results) {
+        double seconds = std::chrono::duration<double>(result->end - result->start).count();
+        file << quoteCsv(result->path) << ',';
+        if (result->loaded && result->finishedRestarts > 0) {
+            file << result->data.jobCount << ',' << result->data.processorCount << ','
+                 << result->finishedRestarts << ',' << result->bestFitness << ','
+                 << result->fitnessSum / result->finishedRestarts << ',' << seconds << ','
+                 << (result->finishedRestarts < result->completedRestarts ? quoteCsv("partial:" + result->error) : "ok")
+                 << '\n';
+        } else {
+            file << ",,0,,," << seconds << ",failed\n";
+        }
+    }
+}
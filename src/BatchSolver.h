@@ -0,0 +1,63 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "ICoolingLaw.h"
+#include "IDataReader.h"
+
+// Пакетное решение множества независимых задач в одном процессе: каждая задача
+// читается из файла и решается несколькими перезапусками SimulatedAnnealing,
+// перезапуски разных задач перемешиваются в пуле с перехватом работы.
+// На каждую задачу - одна строка результата в CSV
+class BatchSolver {
+public:
+    using CoolingLawFactory = std::function<std::shared_ptr<ICoolingLaw>()>;
+
+    explicit BatchSolver(int threadCount);
+
+    void setCoolingLawFactory(CoolingLawFactory factory);
+    void setInitialTemperature(double temperature);
+    void setIterationsPerTemperature(int iterations);
+    void setMaxIterationsWithoutImprovement(int iterations);
+    void setRestarts(int restarts);
+    void setSeed(std::uint64_t seed);
+
+    // Каталог (все *.csv и *.bin в нём по алфавиту) или файл-манифест со списком путей по одному в строке;
+    // относительные пути манифеста считаются от его каталога
+    static std::vector<std::string> collectInstances(const std::string& path);
+
+    // Возвращает число задач, решённых без ошибок
+    int solve(const std::vector<std::string>& instancePaths, const std::string& outputPath);
+
+private:
+    struct InstanceResult {
+        std::string path;
+        InputData data;
+        bool loaded = false;
+        std::string error;
+        double bestFitness = 0.0;
+        double fitnessSum = 0.0;
+        int finishedRestarts = 0;   // перезапуски, завершившиеся без ошибок
+        int completedRestarts = 0;  // все завершённые перезапуски, включая упавшие
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::time_point end;
+        std::mutex mutex;
+    };
+
+    int threadCount_;
+    CoolingLawFactory coolingLawFactory_;
+    double initialTemperature_;
+    int iterationsPerTemperature_;
+    int maxIterationsWithoutImprovement_;
+    int restarts_;
+    std::uint64_t seed_;
+
+    void solveRestart(InstanceResult& result, std::uint64_t instanceSeed, int restart);
+    void finishRestart(InstanceResult& result);
+    static void writeResults(const std::vector<std::unique_ptr<InstanceResult>>& results, const std::string& outputPath);
+};
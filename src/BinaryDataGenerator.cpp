@@ -0,0 +1,54 @@
+#include "BinaryDataGenerator.h"
+#include "BinaryInstanceFormat.h"
+#include "RandomGenerator.h"
+#include <fstream>
+#include <stdexcept>
+
+BinaryDataGenerator::BinaryDataGenerator() {
+    generator_.setSeed(RandomGenerator::clockSeed());
+}
+
+void BinaryDataGenerator::setSeed(std::uint64_t seed) {
+    generator_.setSeed(seed);
+}
+
+void BinaryDataGenerator::setDistribution(InstanceGenerator::Distribution distribution) {
+    generator_.setDistribution(distribution);
+}
+
+void BinaryDataGenerator::setThreadCount(int threadCount) {
+    generator_.setThreadCount(threadCount);
+}
+
+void BinaryDataGenerator::generateData(int jobCount, int processorCount,
+                                       double minDuration, double maxDuration,
+                                       const std::string& outputPath) {
+    if (jobCount <= 0 || processorCount <= 0) {
+        throw std::invalid_argument("Job count and processor count must be positive");
+    }
+
+    if (minDuration <= 0 || maxDuration <= minDuration) {
+        throw std::invalid_argument("Invalid duration range");
+    }
+
+    std::ofstream file(outputPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file: " + outputPath);
+    }
+
+    // Заголовку нужны только размеры задачи, длительности дописываются кусками следом
+    InputData shape{processorCount, jobCount, minDuration, maxDuration, {}};
+    BinaryInstanceHeader header = BinaryInstanceHeader::fromData(shape);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    generator_.generate(jobCount, processorCount, minDuration, maxDuration,
+        [](size_t, const std::vector<double>& durations, std::string& buffer) {
+            buffer.assign(reinterpret_cast<const char*>(durations.data()), durations.size() * sizeof(double));
+        },
+        file);
+
+    file.close();
+    if (!file) {
+        throw std::runtime_error("Cannot write file: " + outputPath);
+    }
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "IDataGenerator.h"
+#include <string>
+
+// Генерация задачи сразу в двоичный формат (BinaryInstanceHeader), без промежуточного CSV
+class BinaryDataGenerator : public IDataGenerator {
+public:
+    BinaryDataGenerator();
+
+    void generateData(int jobCount, int processorCount,
+                      double minDuration, double maxDuration,
+                      const std::string& outputPath) override;
+    void setSeed(std::uint64_t seed) override;
+    void setDistribution(InstanceGenerator::Distribution distribution) override;
+    void setThreadCount(int threadCount) override;
+
+private:
+    InstanceGenerator generator_;
+};
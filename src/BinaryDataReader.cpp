@@ -0,0 +1,40 @@
+#include "BinaryDataReader.h"
+#include "BinaryInstanceFormat.h"
+#include "MappedFile.h"
+#include <cstring>
+#include <stdexcept>
+
+InputData BinaryDataReader::readData(const std::string& inputPath) {
+    MappedFile file(inputPath);
+    if (file.size() < sizeof(BinaryInstanceHeader)) {
+        throw std::runtime_error("Binary instance is too short: " + inputPath);
+    }
+
+    BinaryInstanceHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    header.validate(file.size());
+
+    InputData data;
+    data.processorCount = static_cast<int>(header.processorCount);
+    data.jobCount = static_cast<int>(header.jobCount);
+    data.minDuration = header.minDuration;
+    data.maxDuration = header.maxDuration;
+
+    if (data.minDuration <= 0 || data.maxDuration <= data.minDuration) {
+        throw std::runtime_error("Invalid duration range");
+    }
+
+    // Смещение массива кратно 64, а начало отображения выровнено по странице
+    const double* durations = reinterpret_cast<const double*>(file.data() + sizeof(BinaryInstanceHeader));
+    data.jobDurations.assign(durations, durations + data.jobCount);
+
+    bool outOfRange = false;
+    for (double duration : data.jobDurations) {
+        outOfRange |= duration < data.minDuration || duration > data.maxDuration;
+    }
+    if (outOfRange) {
+        throw std::runtime_error("Job duration out of specified range");
+    }
+
+    return data;
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "IDataReader.h"
+#include <string>
+
+// Чтение двоичного формата (BinaryInstanceHeader) через mmap: заголовок и длительности
+// читаются прямо из отображения, проверка диапазона совмещена с единственным копированием в InputData
+class BinaryDataReader : public IDataReader {
+public:
+    InputData readData(const std::string& inputPath) override;
+};
@@ -0,0 +1,23 @@
+#include "BinaryDataWriter.h"
+#include "BinaryInstanceFormat.h"
+#include <fstream>
+#include <stdexcept>
+
+void BinaryDataWriter::writeData(const InputData& data, const std::string& outputPath) {
+    if (data.jobDurations.size() != static_cast<size_t>(data.jobCount)) {
+        throw std::invalid_argument("Job durations count doesn't match job count");
+    }
+
+    std::ofstream file(outputPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file: " + outputPath);
+    }
+
+    BinaryInstanceHeader header = BinaryInstanceHeader::fromData(data);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(data.jobDurations.data()),
+               static_cast<std::streamsize>(data.jobDurations.size() * sizeof(double)));
+    if (!file) {
+        throw std::runtime_error("Cannot write file: " + outputPath);
+    }
+}
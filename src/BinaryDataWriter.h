@@ -0,0 +1,10 @@
+#pragma once
+
+#include "IDataReader.h"
+#include <string>
+
+// Запись задачи в двоичный формат (BinaryInstanceHeader); используется конвертером из CSV
+class BinaryDataWriter {
+public:
+    static void writeData(const InputData& data, const std::string& outputPath);
+};
@@ -0,0 +1,38 @@
+#include "BinaryInstanceFormat.h"
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+BinaryInstanceHeader BinaryInstanceHeader::fromData(const InputData& data) {
+    BinaryInstanceHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.byteOrderMark = kByteOrderMark;
+    header.processorCount = data.processorCount;
+    header.jobCount = data.jobCount;
+    header.minDuration = data.minDuration;
+    header.maxDuration = data.maxDuration;
+    return header;
+}
+
+void BinaryInstanceHeader::validate(size_t fileSize) const {
+    if (std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("Not a binary instance file");
+    }
+    if (version != kVersion) {
+        throw std::runtime_error("Unsupported binary instance version: " + std::to_string(version));
+    }
+    if (byteOrderMark != kByteOrderMark) {
+        throw std::runtime_error("Binary instance was written with a different byte order");
+    }
+    if (processorCount <= 0 || processorCount > std::numeric_limits<int>::max()) {
+        throw std::runtime_error("Processor count must be positive");
+    }
+    if (jobCount <= 0 || jobCount > std::numeric_limits<int>::max()) {
+        throw std::runtime_error("Job count must be positive");
+    }
+    if (fileSize != sizeof(BinaryInstanceHeader) + static_cast<size_t>(jobCount) * sizeof(double)) {
+        throw std::runtime_error("Binary instance size doesn't match job count");
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "IDataReader.h"
+
+// Двоичный формат задачи: заголовок из 64 байт, затем jobCount длительностей double
+// в порядке байтов машины. Массив начинается с границы 64 байт от начала файла,
+// поэтому из отображённого файла его можно читать на месте
+struct BinaryInstanceHeader {
+    static constexpr char kMagic[8] = {'P', 'C', 'M', 'A', 'X', 'B', 'I', 'N'};
+    static constexpr std::uint32_t kVersion = 1;
+    // Записывается как есть: при чтении на машине с другим порядком байтов не совпадёт
+    static constexpr std::uint32_t kByteOrderMark = 0x01020304;
+
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrderMark;
+    std::int64_t processorCount;
+    std::int64_t jobCount;
+    double minDuration;
+    double maxDuration;
+    std::uint64_t reserved[2];
+
+    static BinaryInstanceHeader fromData(const InputData& data);
+    // Проверяет заголовок и соответствие размера файла числу работ
+    void validate(size_t fileSize) const;
+};
+
+static_assert(sizeof(BinaryInstanceHeader) == 64, "Binary instance header must be 64 bytes");
@@ -11,3 +11,7 @@ double BoltzmannCooling::cool(int iteration) {
 void BoltzmannCooling::initialize(double temperature) {
     temperature_ = temperature;
 }
+
+std::shared_ptr<ICoolingLaw> BoltzmannCooling::clone() const {
+    return std::make_shared<BoltzmannCooling>(*this);
+}
@@ -1,45 +1,79 @@
 #include "CSVDataGenerator.h"
+#include <charconv>
 #include <fstream>
-#include <random>
-#include <chrono>
+#include <stdexcept>
+#include <string>
+#include "RandomGenerator.h"
+
+namespace {
+
+// Кратчайшая запись, из которой число восстанавливается точно, укладывается в 24 символа
+constexpr size_t kMaxDurationChars = 24;
+
+// Границы пишутся так же, как и длительности, иначе округлённый заголовок может не вместить их
+std::string formatDuration(double duration) {
+    char buffer[kMaxDurationChars];
+    return std::string(buffer, std::to_chars(buffer, buffer + kMaxDurationChars, duration).ptr);
+}
+
+}
+
+CSVDataGenerator::CSVDataGenerator() {
+    generator_.setSeed(RandomGenerator::clockSeed());
+}
+
+void CSVDataGenerator::setSeed(std::uint64_t seed) {
+    generator_.setSeed(seed);
+}
+
+void CSVDataGenerator::setDistribution(InstanceGenerator::Distribution distribution) {
+    generator_.setDistribution(distribution);
+}
+
+void CSVDataGenerator::setThreadCount(int threadCount) {
+    generator_.setThreadCount(threadCount);
+}
 
 void CSVDataGenerator::generateData(int jobCount, int processorCount,
                                    double minDuration, double maxDuration,
                                    const std::string& outputPath) {
-    
+
     if (jobCount <= 0 || processorCount <= 0) {
         throw std::invalid_argument("Job count and processor count must be positive");
     }
-    
+
     if (minDuration <= 0 || maxDuration <= minDuration) {
         throw std::invalid_argument("Invalid duration range");
     }
-    
-    std::ofstream file(outputPath);
+
+    std::ofstream file(outputPath, std::ios::binary | std::ios::trunc);
     if (!file.is_open()) {
         throw std::runtime_error("Cannot open file: " + outputPath);
     }
-    
+
     file << "processor_count,job_count,min_duration,max_duration\n";
-    file << processorCount << "," << jobCount << "," << minDuration << "," << maxDuration << "\n";
-    
+    file << processorCount << "," << jobCount << "," << formatDuration(minDuration) << ","
+         << formatDuration(maxDuration) << "\n";
+
     file << "job_durations\n";
-    auto seed = std::chrono::steady_clock::now().time_since_epoch().count();
-    std::mt19937 generator(static_cast<unsigned int>(seed));
-    std::uniform_real_distribution<double> distribution(minDuration, maxDuration);
-    
-    std::vector<double> durations(jobCount);
-    for (int i = 0; i < jobCount; ++i) {
-        durations[i] = distribution(generator);
-    }
-    
-    for (size_t i = 0; i < durations.size(); ++i) {
-        file << durations[i];
-        if (i < durations.size() - 1) {
-            file << ",";
-        }
-    }
+    generator_.generate(jobCount, processorCount, minDuration, maxDuration,
+        [](size_t chunkIndex, const std::vector<double>& durations, std::string& buffer) {
+            buffer.resize(durations.size() * (kMaxDurationChars + 1));
+            char* position = buffer.data();
+            char* end = position + buffer.size();
+            for (size_t i = 0; i < durations.size(); ++i) {
+                if (chunkIndex > 0 || i > 0) {
+                    *position++ = ',';
+                }
+                position = std::to_chars(position, end, durations[i]).ptr;
+            }
+            buffer.resize(position - buffer.data());
+        },
+        file);
     file << "\n";
-    
+
     file.close();
-}
\ No newline at end of file
+    if (!file) {
+        throw std::runtime_error("Cannot write file: " + outputPath);
+    }
+}
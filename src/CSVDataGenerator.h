@@ -6,7 +6,15 @@
 
 class CSVDataGenerator : public IDataGenerator {
 public:
+    CSVDataGenerator();
+
     void generateData(int jobCount, int processorCount,
                      double minDuration, double maxDuration,
                      const std::string& outputPath) override;
-};
\ No newline at end of file
+    void setSeed(std::uint64_t seed) override;
+    void setDistribution(InstanceGenerator::Distribution distribution) override;
+    void setThreadCount(int threadCount) override;
+
+private:
+    InstanceGenerator generator_;
+};
@@ -10,3 +10,7 @@ double CauchyCooling::cool(int iteration) {
 void CauchyCooling::initialize(double temperature) {
     temperature_ = temperature;
 }
+
+std::shared_ptr<ICoolingLaw> CauchyCooling::clone() const {
+    return std::make_shared<CauchyCooling>(*this);
+}
@@ -6,6 +6,7 @@ class CauchyCooling : public ICoolingLaw {
 public:
     void initialize(double temperature) override;
     double cool(int iteration) override;
+    std::shared_ptr<ICoolingLaw> clone() const override;
 private:
     double temperature_;
 };
\ No newline at end of file
@@ -0,0 +1,13 @@
+#include "ConstantCooling.h"
+
+double ConstantCooling::cool(int) {
+    return temperature_;
+}
+
+void ConstantCooling::initialize(double temperature) {
+    temperature_ = temperature;
+}
+
+std::shared_ptr<ICoolingLaw> ConstantCooling::clone() const {
+    return std::make_shared<ConstantCooling>(*this);
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "ICoolingLaw.h"
+
+// Температура не меняется: используется репликами параллельного отжига с обменом (tempering)
+class ConstantCooling : public ICoolingLaw {
+public:
+    void initialize(double temperature) override;
+    double cool(int iteration) override;
+    std::shared_ptr<ICoolingLaw> clone() const override;
+private:
+    double temperature_;
+};
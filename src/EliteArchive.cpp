@@ -0,0 +1,80 @@
+#include "EliteArchive.h"
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+EliteArchive::EliteArchive(int capacity, int minDistance)
+    : capacity_(capacity)
+    , minDistance_(minDistance) {
+    if (capacity_ <= 0) {
+        throw std::invalid_argument("Elite archive capacity must be positive");
+    }
+    if (minDistance_ < 0) {
+        throw std::invalid_argument("Elite archive distance must be non-negative");
+    }
+    entries_.reserve(capacity_ + 1);
+}
+
+bool EliteArchive::offer(const std::shared_ptr<ISolution>& solution, double fitness) {
+    if (!solution) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Записи отсортированы по возрастанию фитнеса
+    if (static_cast<int>(entries_.size()) == capacity_ && fitness >= entries_.back().fitness) {
+        return false;
+    }
+
+    // Близкое решение не хуже уже есть - новое ничего не добавляет к разнообразию
+    for (const auto& entry : entries_) {
+        if (solution->distanceTo(*entry.solution) < minDistance_ && entry.fitness <= fitness) {
+            return false;
+        }
+    }
+
+    // Оставшиеся близкие решения хуже нового и вытесняются им
+    entries_.erase(std::remove_if(entries_.begin(), entries_.end(), [&](const Entry& entry) {
+        return solution->distanceTo(*entry.solution) < minDistance_;
+    }), entries_.end());
+
+    auto position = std::upper_bound(entries_.begin(), entries_.end(), fitness,
+        [](double value, const Entry& entry) { return value < entry.fitness; });
+    entries_.insert(position, Entry{solution->clone(), fitness});
+
+    if (static_cast<int>(entries_.size()) > capacity_) {
+        entries_.pop_back();
+    }
+    return true;
+}
+
+std::shared_ptr<ISolution> EliteArchive::select(RandomGenerator& generator) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (entries_.empty()) {
+        return nullptr;
+    }
+
+    std::uniform_int_distribution<size_t> distribution(0, entries_.size() - 1);
+    return entries_[distribution(generator)].solution->clone();
+}
+
+std::shared_ptr<ISolution> EliteArchive::best() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.empty() ? nullptr : entries_.front().solution->clone();
+}
+
+double EliteArchive::bestFitness() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.empty() ? std::numeric_limits<double>::max() : entries_.front().fitness;
+}
+
+int EliteArchive::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int>(entries_.size());
+}
+
+int EliteArchive::capacity() const {
+    return capacity_;
+}
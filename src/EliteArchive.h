@@ -0,0 +1,34 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "ISolution.h"
+#include "RandomGenerator.h"
+
+// Ограниченный архив лучших попарно различных решений. Два решения различны,
+// если расстояние между ними (ISolution::distanceTo) не меньше minDistance.
+// Потокобезопасен: в него пишут и из него читают все рабочие потоки
+class EliteArchive {
+public:
+    EliteArchive(int capacity, int minDistance);
+
+    bool offer(const std::shared_ptr<ISolution>& solution, double fitness);
+    std::shared_ptr<ISolution> select(RandomGenerator& generator) const;
+    std::shared_ptr<ISolution> best() const;
+    double bestFitness() const;
+
+    int size() const;
+    int capacity() const;
+
+private:
+    struct Entry {
+        std::shared_ptr<ISolution> solution;
+        double fitness;
+    };
+
+    int capacity_;
+    int minDistance_;
+    std::vector<Entry> entries_;
+    mutable std::mutex mutex_;
+};
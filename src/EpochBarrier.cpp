@@ -0,0 +1,61 @@
+#include "EpochBarrier.h"
+
+EpochBarrier::EpochBarrier()
+    : epoch_(0)
+    , arrivedCount_(0)
+    , activeCount_(0)
+    , stopped_(false) {
+}
+
+void EpochBarrier::reset(int participants) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    epoch_ = 0;
+    arrivedCount_ = 0;
+    activeCount_ = participants;
+    stopped_ = false;
+}
+
+bool EpochBarrier::arriveAndWait(std::uint64_t& epoch) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    ++arrivedCount_;
+    condition_.notify_all();
+    condition_.wait(lock, [this, epoch] { return epoch_ != epoch || stopped_; });
+    epoch = epoch_;
+    return !stopped_;
+}
+
+void EpochBarrier::leave() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        --activeCount_;
+    }
+    condition_.notify_all();
+}
+
+bool EpochBarrier::waitForAll() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait(lock, [this] { return arrivedCount_ >= activeCount_ || stopped_; });
+    return !stopped_ && activeCount_ > 0;
+}
+
+void EpochBarrier::release() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        arrivedCount_ = 0;
+        ++epoch_;
+    }
+    condition_.notify_all();
+}
+
+void EpochBarrier::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+    }
+    condition_.notify_all();
+}
+
+int EpochBarrier::activeCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return activeCount_;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+// Барьер эпох между рабочими потоками и координатором: потоки отмечаются и ждут,
+// координатор дожидается всех активных, выполняет синхронизацию и открывает следующую эпоху.
+// Поток может выйти из барьера навсегда (leave), stop() будит всех ожидающих
+class EpochBarrier {
+public:
+    EpochBarrier();
+
+    void reset(int participants);
+
+    // Для рабочих потоков: epoch - номер последней эпохи, увиденной потоком
+    bool arriveAndWait(std::uint64_t& epoch);
+    void leave();
+
+    // Для координатора: false, если барьер остановлен или активных потоков не осталось
+    bool waitForAll();
+    void release();
+
+    void stop();
+    int activeCount() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::condition_variable condition_;
+    std::uint64_t epoch_;
+    int arrivedCount_;
+    int activeCount_;
+    bool stopped_;
+};
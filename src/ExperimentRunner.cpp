@@ -0,0 +1,282 @@
+#include "ExperimentRunner.h"
+#include "Logger.h"
+#include "ParallelSimulatedAnnealing.h"
+#include "RandomGenerator.h"
+#include "SampleStatistics.h"
+#include "ScheduleMutation.h"
+#include "SolutionGenerator.h"
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+std::ofstream openOutput(const std::string& path) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+    return file;
+}
+
+// Поле CSV в кавычках, если в нём есть разделитель, кавычка или перевод строки
+std::string quoteCsv(const std::string& field) {
+    if (field.find_first_of(",\"\r\n") == std::string::npos) {
+        return field;
+    }
+    std::string quoted = "\"";
+    for (char c : field) {
+        if (c == '"') {
+            quoted += '"';
+        }
+        quoted += c;
+    }
+    quoted += '"';
+    return quoted;
+}
+
+// Имена задач берутся из путей пользователя, поэтому кавычки и управляющие символы экранируются
+std::string escapeJson(const std::string& text) {
+    static const char* const kHex = "0123456789abcdef";
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (char c : text) {
+        switch (c) {
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\r': escaped += "\\r"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    escaped += "\\u00";
+                    escaped += kHex[(c >> 4) & 0xF];
+                    escaped += kHex[c & 0xF];
+                } else {
+                    escaped += c;
+                }
+        }
+    }
+    return escaped;
+}
+
+}
+
+ExperimentRunner::ExperimentRunner(const Grid& grid, CoolingLawFactory coolingLawFactory)
+    : grid_(grid)
+    , coolingLawFactory_(std::move(coolingLawFactory))
+    , seed_(RandomGenerator::clockSeed()) {
+    if (grid_.trials <= 0) {
+        throw std::invalid_argument("Trial count must be positive");
+    }
+    if (grid_.threadCounts.empty() || grid_.coolingLaws.empty() || grid_.initialTemperatures.empty() ||
+        grid_.iterationsPerTemperature.empty() || grid_.exchangeIntervals.empty()) {
+        throw std::invalid_argument("Every grid dimension needs at least one value");
+    }
+    SolutionGenerator::validateMethod(grid_.initialSolution);
+    buildConfigurations();
+}
+
+void ExperimentRunner::setSeed(std::uint64_t seed) {
+    seed_ = seed;
+}
+
+void ExperimentRunner::addInstance(const std::string& name, InputData data) {
+    instances_.push_back({name, std::move(data)});
+}
+
+void ExperimentRunner::buildConfigurations() {
+    for (const auto& coolingLaw : grid_.coolingLaws) {
+        coolingLawFactory_(coolingLaw);
+        for (double temperature : grid_.initialTemperatures) {
+            for (int iterations : grid_.iterationsPerTemperature) {
+                for (int interval : grid_.exchangeIntervals) {
+                    for (int threads : grid_.threadCounts) {
+                        if (threads <= 0 || temperature <= 0 || iterations <= 0 || interval <= 0) {
+                            throw std::invalid_argument("Grid values must be positive");
+                        }
+                        configurations_.push_back({threads, coolingLaw, temperature, iterations, interval});
+                    }
+                }
+            }
+        }
+    }
+}
+
+void ExperimentRunner::run() {
+    if (instances_.empty()) {
+        throw std::logic_error("No instances to run experiments on");
+    }
+
+    size_t total = instances_.size() * configurations_.size() * grid_.trials;
+    LOG_INFO("Experiment STARTED: instances=" + std::to_string(instances_.size()) +
+             ", configurations=" + std::to_string(configurations_.size()) +
+             ", trials=" + std::to_string(grid_.trials));
+
+    // Повторы выполняются по одному: параллельные прогоны исказили бы замеры времени
+    trials_.clear();
+    trials_.reserve(total);
+    for (size_t instance = 0; instance < instances_.size(); ++instance) {
+        for (size_t configuration = 0; configuration < configurations_.size(); ++configuration) {
+            for (int trial = 0; trial < grid_.trials; ++trial) {
+                trials_.push_back(runTrial(instance, configuration, trial));
+
+                const Configuration& config = configurations_[configuration];
+                std::cout << "[" << trials_.size() << "/" << total << "] " << instances_[instance].name
+                          << " threads=" << config.threads << " law=" << config.coolingLaw
+                          << " T0=" << config.initialTemperature << " trial=" << trial
+                          << ": fitness=" << trials_.back().bestFitness
+                          << ", time=" << trials_.back().wallSeconds << " s" << std::endl;
+            }
+        }
+    }
+
+    LOG_INFO("Experiment FINISHED: trials=" + std::to_string(trials_.size()));
+}
+
+ExperimentRunner::Trial ExperimentRunner::runTrial(size_t instanceIndex, size_t configurationIndex, int trial) const {
+    const InputData& data = instances_[instanceIndex].data;
+    const Configuration& config = configurations_[configurationIndex];
+    std::uint64_t trialSeed = RandomGenerator::deriveSeed(RandomGenerator::deriveSeed(seed_, instanceIndex), trial);
+
+    auto initialSolution = SolutionGenerator::generateSolution(grid_.initialSolution, data.jobCount, data.processorCount,
+                                                              data.jobDurations, RandomGenerator::deriveSeed(trialSeed, 2));
+    auto coolingLaw = coolingLawFactory_(config.coolingLaw);
+    coolingLaw->initialize(config.initialTemperature);
+
+    ParallelSimulatedAnnealing psa(config.threads);
+    psa.setInitialSolution(initialSolution);
+    psa.setMutation(std::make_shared<ScheduleMutation>());
+    psa.setCoolingLaw(coolingLaw);
+    psa.setInitialTemperature(config.initialTemperature);
+    psa.setIterationsPerTemperature(config.iterationsPerTemperature);
+    psa.setMaxIterationsWithoutImprovement(grid_.maxIterationsWithoutImprovement);
+    psa.setMaxIterationsWithoutImprovementGlobal(grid_.maxIterationsWithoutImprovementGlobal);
+    psa.setExchangeInterval(config.exchangeInterval);
+    // Как в main.cpp: поток 1 - зерно PSA, поток 2 - начальное решение; иначе начальное решение
+    // и критерий принятия нулевого потока PSA брали бы числа из одной последовательности
+    psa.setSeed(RandomGenerator::deriveSeed(trialSeed, 1));
+
+    auto bestSolution = psa.run();
+    ParallelMetrics metrics = psa.getMetrics();
+
+    Trial result;
+    result.instance = instanceIndex;
+    result.configuration = configurationIndex;
+    result.trial = trial;
+    result.seed = trialSeed;
+    result.wallSeconds = metrics.wallSeconds;
+    result.iterationsPerSecond = metrics.iterationsPerSecond();
+    result.initialFitness = initialSolution->fitness();
+    result.bestFitness = bestSolution ? bestSolution->fitness() : result.initialFitness;
+    return result;
+}
+
+std::vector<double> ExperimentRunner::collect(size_t instance, size_t configuration, double Trial::*field) const {
+    std::vector<double> values;
+    for (const auto& trial : trials_) {
+        if (trial.instance == instance && trial.configuration == configuration) {
+            values.push_back(trial.*field);
+        }
+    }
+    return values;
+}
+
+double ExperimentRunner::speedup(size_t instance, size_t configuration) const {
+    const Configuration& config = configurations_[configuration];
+    for (size_t baseline = 0; baseline < configurations_.size(); ++baseline) {
+        const Configuration& candidate = configurations_[baseline];
+        if (candidate.threads == 1 && candidate.coolingLaw == config.coolingLaw &&
+            candidate.initialTemperature == config.initialTemperature &&
+            candidate.iterationsPerTemperature == config.iterationsPerTemperature &&
+            candidate.exchangeInterval == config.exchangeInterval) {
+            double baselineTime = SampleStatistics::compute(collect(instance, baseline, &Trial::wallSeconds)).mean;
+            double time = SampleStatistics::compute(collect(instance, configuration, &Trial::wallSeconds)).mean;
+            return time > 0.0 ? baselineTime / time : 0.0;
+        }
+    }
+    return 0.0;
+}
+
+void ExperimentRunner::writeTrialsCsv(const std::string& path) const {
+    std::ofstream file = openOutput(path);
+    file << "instance,job_count,processor_count,threads,cooling_law,initial_temperature,iterations_per_temperature,"
+            "exchange_interval,trial,seed,wall_seconds,iterations_per_second,initial_fitness,best_fitness\n";
+    for (const auto& trial : trials_) {
+        const Instance& instance = instances_[trial.instance];
+        const Configuration& config = configurations_[trial.configuration];
+        file << quoteCsv(instance.name) << ',' << instance.data.jobCount << ',' << instance.data.processorCount << ','
+             << config.threads << ',' << quoteCsv(config.coolingLaw) << ',' << config.initialTemperature << ','
+             << config.iterationsPerTemperature << ',' << config.exchangeInterval << ','
+             << trial.trial << ',' << trial.seed << ',' << trial.wallSeconds << ',' << trial.iterationsPerSecond << ','
+             << trial.initialFitness << ',' << trial.bestFitness << '\n';
+    }
+}
+
+void ExperimentRunner::writeSummaryCsv(const std::string& path) const {
+    const std::pair<const char*, double Trial::*> metrics[] = {
+        {"wall_seconds", &Trial::wallSeconds},
+        {"iterations_per_second", &Trial::iterationsPerSecond},
+        {"best_fitness", &Trial::bestFitness},
+    };
+
+    std::ofstream file = openOutput(path);
+    file << "instance,job_count,processor_count,threads,cooling_law,initial_temperature,iterations_per_temperature,"
+            "exchange_interval,trials";
+    for (const auto& metric : metrics) {
+        for (const char* statistic : {"mean", "median", "stddev", "ci95_low", "ci95_high"}) {
+            file << ',' << metric.first << '_' << statistic;
+        }
+    }
+    file << ",speedup\n";
+
+    for (size_t instance = 0; instance < instances_.size(); ++instance) {
+        for (size_t configuration = 0; configuration < configurations_.size(); ++configuration) {
+            const Instance& data = instances_[instance];
+            const Configuration& config = configurations_[configuration];
+            file << quoteCsv(data.name) << ',' << data.data.jobCount << ',' << data.data.processorCount << ','
+                 << config.threads << ',' << quoteCsv(config.coolingLaw) << ',' << config.initialTemperature << ','
+                 << config.iterationsPerTemperature << ',' << config.exchangeInterval << ','
+                 << collect(instance, configuration, &Trial::wallSeconds).size();
+            for (const auto& metric : metrics) {
+                SampleStatistics statistics = SampleStatistics::compute(collect(instance, configuration, metric.second));
+                file << ',' << statistics.mean << ',' << statistics.median << ',' << statistics.standardDeviation
+                     << ',' << statistics.confidenceLow << ',' << statistics.confidenceHigh;
+            }
+            double ratio = speedup(instance, configuration);
+            file << ',';
+            if (ratio > 0.0) {
+                file << ratio;
+            }
+            file << '\n';
+        }
+    }
+}
+
+void ExperimentRunner::writeSummaryJson(const std::string& path) const {
+    std::ofstream file = openOutput(path);
+    file << "{\"seed\":" << seed_ << ",\"trials\":" << grid_.trials << ",\"results\":[";
+    bool first = true;
+    for (size_t instance = 0; instance < instances_.size(); ++instance) {
+        for (size_t configuration = 0; configuration < configurations_.size(); ++configuration) {
+            const Instance& data = instances_[instance];
+            const Configuration& config = configurations_[configuration];
+            file << (first ? "" : ",") << "\n{\"instance\":\"" << escapeJson(data.name) << "\""
+                 << ",\"job_count\":" << data.data.jobCount
+                 << ",\"processor_count\":" << data.data.processorCount
+                 << ",\"threads\":" << config.threads
+                 << ",\"cooling_law\":\"" << escapeJson(config.coolingLaw) << "\""
+                 << ",\"initial_temperature\":" << config.initialTemperature
+                 << ",\"iterations_per_temperature\":" << config.iterationsPerTemperature
+                 << ",\"exchange_interval\":" << config.exchangeInterval
+                 << ",\"wall_seconds\":" << SampleStatistics::compute(collect(instance, configuration, &Trial::wallSeconds)).toJson()
+                 << ",\"iterations_per_second\":" << SampleStatistics::compute(collect(instance, configuration, &Trial::iterationsPerSecond)).toJson()
+                 << ",\"best_fitness\":" << SampleStatistics::compute(collect(instance, configuration, &Trial::bestFitness)).toJson()
+                 << ",\"speedup\":" << speedup(instance, configuration)
+                 << "}";
+            first = false;
+        }
+    }
+    file << "\n]}" << std::endl;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ICoolingLaw.h"
+#include "IDataReader.h"
+
+// Серия экспериментов в одном процессе: декартово произведение параметров сетки на набор
+// задач, по trials повторов с разными зёрнами. Зерно повтора зависит только от задачи и номера
+// повтора, поэтому все конфигурации сравниваются на одних и тех же случайных потоках
+class ExperimentRunner {
+public:
+    struct Grid {
+        std::vector<int> threadCounts = {1};
+        std::vector<std::string> coolingLaws = {"boltzmann"};
+        std::vector<double> initialTemperatures = {100.0};
+        std::vector<int> iterationsPerTemperature = {100};
+        std::vector<int> exchangeIntervals = {100};
+        int maxIterationsWithoutImprovement = 100;
+        int maxIterationsWithoutImprovementGlobal = 1;
+        std::string initialSolution = "worst";
+        int trials = 5;
+    };
+
+    using CoolingLawFactory = std::function<std::shared_ptr<ICoolingLaw>(const std::string&)>;
+
+    ExperimentRunner(const Grid& grid, CoolingLawFactory coolingLawFactory);
+
+    void setSeed(std::uint64_t seed);
+    void addInstance(const std::string& name, InputData data);
+
+    void run();
+
+    // Сырые результаты повторов и сводка по каждой паре (задача, конфигурация)
+    void writeTrialsCsv(const std::string& path) const;
+    void writeSummaryCsv(const std::string& path) const;
+    void writeSummaryJson(const std::string& path) const;
+
+private:
+    struct Instance {
+        std::string name;
+        InputData data;
+    };
+
+    struct Configuration {
+        int threads;
+        std::string coolingLaw;
+        double initialTemperature;
+        int iterationsPerTemperature;
+        int exchangeInterval;
+    };
+
+    struct Trial {
+        size_t instance;
+        size_t configuration;
+        int trial;
+        std::uint64_t seed;
+        double wallSeconds;
+        double iterationsPerSecond;
+        double initialFitness;
+        double bestFitness;
+    };
+
+    Grid grid_;
+    CoolingLawFactory coolingLawFactory_;
+    std::uint64_t seed_;
+    std::vector<Instance> instances_;
+    std::vector<Configuration> configurations_;
+    std::vector<Trial> trials_;
+
+    void buildConfigurations();
+    Trial runTrial(size_t instanceIndex, size_t configurationIndex, int trial) const;
+    std::vector<double> collect(size_t instance, size_t configuration, double Trial::*field) const;
+    // Отношение среднего времени однопоточной конфигурации с теми же параметрами к среднему времени этой; 0 - нет пары
+    double speedup(size_t instance, size_t configuration) const;
+};
@@ -0,0 +1,122 @@
+#include "ExtremumTree.h"
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <stdexcept>
+
+ExtremumTree::ExtremumTree()
+    : size_(0)
+    , kind_(Kind::Max) {
+}
+
+ExtremumTree::ExtremumTree(int size, Kind kind)
+    : size_(size)
+    , kind_(kind) {
+    if (size_ < 0) {
+        throw std::invalid_argument("Tree size must be non-negative");
+    }
+    nodes_.assign(2 * static_cast<size_t>(size_), identity());
+}
+
+void ExtremumTree::set(int index, double value) {
+    if (index < 0 || index >= size_) {
+        throw std::out_of_range("Tree index out of range");
+    }
+
+    int position = index + size_;
+    nodes_[position] = value;
+    for (position /= 2; position >= 1; position /= 2) {
+        nodes_[position] = combine(nodes_[2 * position], nodes_[2 * position + 1]);
+    }
+}
+
+double ExtremumTree::get(int index) const {
+    if (index < 0 || index >= size_) {
+        throw std::out_of_range("Tree index out of range");
+    }
+    return nodes_[index + size_];
+}
+
+double ExtremumTree::top() const {
+    return query(0, size_);
+}
+
+double ExtremumTree::topExcept(int firstIndex, int secondIndex) const {
+    int lower = std::min(firstIndex, secondIndex);
+    int upper = std::max(firstIndex, secondIndex);
+
+    double result = query(0, lower);
+    if (lower != upper) {
+        result = combine(result, query(lower + 1, upper));
+    }
+    return combine(result, query(upper + 1, size_));
+}
+
+void ExtremumTree::topElements(int count, int* indices, double* values) const {
+    // Узел равен экстремуму своего поддерева, поэтому лучшие листья извлекаются
+    // поиском по первому наилучшему: граница обхода растёт на один узел за шаг спуска
+    // Каждый спуск к листу раскрывает не больше 32 узлов, так что граница ограничена сверху
+    if (count < 0 || count > kMaxTopElements) {
+        throw std::invalid_argument("Too many top elements requested");
+    }
+    std::array<int, kMaxTopElements * 32 + 1> frontier;
+    int frontierSize = 0;
+    if (size_ > 0) {
+        frontier[frontierSize++] = 1;
+    }
+
+    int found = 0;
+    while (found < count && frontierSize > 0) {
+        int best = 0;
+        for (int i = 1; i < frontierSize; ++i) {
+            if (combine(nodes_[frontier[i]], nodes_[frontier[best]]) != nodes_[frontier[best]]) {
+                best = i;
+            }
+        }
+        int node = frontier[best];
+        frontier[best] = frontier[--frontierSize];
+
+        if (node >= size_) {
+            indices[found] = node - size_;
+            values[found] = nodes_[node];
+            ++found;
+        } else {
+            frontier[frontierSize++] = 2 * node;
+            frontier[frontierSize++] = 2 * node + 1;
+        }
+    }
+
+    for (; found < count; ++found) {
+        indices[found] = -1;
+        values[found] = identity();
+    }
+}
+
+int ExtremumTree::size() const {
+    return size_;
+}
+
+double ExtremumTree::identity() const {
+    return kind_ == Kind::Max ? std::numeric_limits<double>::lowest()
+                              : std::numeric_limits<double>::max();
+}
+
+double ExtremumTree::combine(double first, double second) const {
+    return kind_ == Kind::Max ? std::max(first, second) : std::min(first, second);
+}
+
+double ExtremumTree::query(int begin, int end) const {
+    double result = identity();
+    begin = std::max(begin, 0);
+    end = std::min(end, size_);
+
+    for (begin += size_, end += size_; begin < end; begin /= 2, end /= 2) {
+        if (begin & 1) {
+            result = combine(result, nodes_[begin++]);
+        }
+        if (end & 1) {
+            result = combine(result, nodes_[--end]);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <vector>
+
+// Дерево отрезков над небольшим массивом (по одному элементу на процессор):
+// обновление и запрос экстремума за O(log M)
+class ExtremumTree {
+public:
+    enum class Kind { Max, Min };
+
+    static constexpr int kMaxTopElements = 4;
+
+    ExtremumTree();
+    ExtremumTree(int size, Kind kind);
+
+    void set(int index, double value);
+    double get(int index) const;
+    double top() const;
+    double topExcept(int firstIndex, int secondIndex) const;
+    // count лучших элементов в порядке убывания приоритета за O(count log M);
+    // недостающие позиции заполняются индексом -1 и нейтральным значением
+    void topElements(int count, int* indices, double* values) const;
+    int size() const;
+
+private:
+    int size_;
+    Kind kind_;
+    std::vector<double> nodes_;
+
+    double identity() const;
+    double combine(double first, double second) const;
+    double query(int begin, int end) const;
+};
@@ -0,0 +1,158 @@
+#include "FastCSVDataReader.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Меньшие куски не окупают запуск потока
+constexpr size_t kMinChunkBytes = 1 << 20;
+
+// Строка без завершающих \n и \r; begin сдвигается на начало следующей строки
+std::pair<const char*, const char*> nextLine(const char*& begin, const char* end) {
+    const char* lineEnd = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+    if (!lineEnd) {
+        lineEnd = end;
+    }
+    const char* lineBegin = begin;
+    begin = lineEnd == end ? end : lineEnd + 1;
+    while (lineEnd > lineBegin && lineEnd[-1] == '\r') {
+        --lineEnd;
+    }
+    return {lineBegin, lineEnd};
+}
+
+template <typename Value>
+const char* parseField(const char* begin, const char* end, Value& value, const char* name) {
+    auto result = std::from_chars(begin, end, value);
+    if (result.ec != std::errc()) {
+        throw std::runtime_error(std::string("Cannot parse ") + name);
+    }
+    if (result.ptr != end) {
+        if (*result.ptr != ',') {
+            throw std::runtime_error(std::string("Unexpected character after ") + name);
+        }
+        ++result.ptr;
+    }
+    return result.ptr;
+}
+
+}
+
+FastCSVDataReader::FastCSVDataReader()
+    : threadCount_(static_cast<int>(std::max(1u, std::thread::hardware_concurrency()))) {
+}
+
+void FastCSVDataReader::setThreadCount(int threadCount) {
+    threadCount_ = std::max(1, threadCount);
+}
+
+InputData FastCSVDataReader::readData(const std::string& inputPath) {
+    MappedFile file(inputPath);
+    const char* position = file.data();
+    const char* end = position + file.size();
+
+    InputData data;
+
+    nextLine(position, end);
+    auto sizes = nextLine(position, end);
+    const char* field = sizes.first;
+    field = parseField(field, sizes.second, data.processorCount, "processor count");
+    field = parseField(field, sizes.second, data.jobCount, "job count");
+    field = parseField(field, sizes.second, data.minDuration, "min duration");
+    parseField(field, sizes.second, data.maxDuration, "max duration");
+
+    if (data.processorCount <= 0) {
+        throw std::runtime_error("Processor count must be positive");
+    }
+    if (data.jobCount <= 0) {
+        throw std::runtime_error("Job count must be positive");
+    }
+    if (data.minDuration <= 0 || data.maxDuration <= data.minDuration) {
+        throw std::runtime_error("Invalid duration range");
+    }
+
+    nextLine(position, end);
+    auto durations = nextLine(position, end);
+    parseDurations(durations.first, durations.second, data);
+
+    return data;
+}
+
+void FastCSVDataReader::parseDurations(const char* begin, const char* end, InputData& data) const {
+    size_t length = static_cast<size_t>(end - begin);
+    size_t chunkCount = std::max<size_t>(1, std::min<size_t>(threadCount_, length / kMinChunkBytes));
+
+    // Границы кусков сдвигаются к ближайшей запятой справа, чтобы число не резалось пополам
+    std::vector<const char*> bounds(chunkCount + 1, end);
+    bounds[0] = begin;
+    for (size_t i = 1; i < chunkCount; ++i) {
+        const char* bound = std::max(bounds[i - 1], begin + length / chunkCount * i);
+        const char* comma = static_cast<const char*>(std::memchr(bound, ',', end - bound));
+        bounds[i] = comma ? comma + 1 : end;
+    }
+
+    // Подсчёт запятых намного дешевле разбора чисел: по нему заранее известно, с какого индекса
+    // каждый кусок пишет в итоговый массив, и склеивать результаты потоков не нужно
+    std::vector<size_t> offsets(chunkCount + 1, 0);
+    for (size_t i = 0; i < chunkCount; ++i) {
+        size_t values = 0;
+        if (bounds[i] != bounds[i + 1]) {
+            values = std::count(bounds[i], bounds[i + 1], ',') + (i + 1 == chunkCount ? 1 : 0);
+        }
+        offsets[i + 1] = offsets[i] + values;
+    }
+    if (offsets[chunkCount] != static_cast<size_t>(data.jobCount)) {
+        throw std::runtime_error("Job durations count doesn't match job count");
+    }
+    data.jobDurations.resize(data.jobCount);
+
+    double minDuration = data.minDuration;
+    double maxDuration = data.maxDuration;
+    double* output = data.jobDurations.data();
+    std::vector<std::exception_ptr> errors(chunkCount);
+
+    auto parseChunk = [&](size_t chunk) {
+        try {
+            const char* cursor = bounds[chunk];
+            const char* chunkEnd = bounds[chunk + 1];
+            double* target = output + offsets[chunk];
+            bool outOfRange = false;
+            while (cursor < chunkEnd) {
+                double value;
+                auto result = std::from_chars(cursor, chunkEnd, value);
+                if (result.ec != std::errc() || (result.ptr != chunkEnd && *result.ptr != ',')) {
+                    throw std::runtime_error("Cannot parse job duration at byte " + std::to_string(cursor - bounds[0]));
+                }
+                outOfRange |= value < minDuration || value > maxDuration;
+                *target++ = value;
+                cursor = result.ptr + 1;
+            }
+            if (outOfRange) {
+                throw std::runtime_error("Job duration out of specified range");
+            }
+        } catch (...) {
+            errors[chunk] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < chunkCount; ++i) {
+        threads.emplace_back(parseChunk, i);
+    }
+    parseChunk(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "IDataReader.h"
+#include <cstddef>
+#include <string>
+
+// Быстрое чтение CSV в формате CSVDataGenerator: файл отображается в память целиком,
+// числа разбираются std::from_chars без промежуточных строк, строка длительностей
+// делится на куски, которые разбираются параллельно сразу в итоговый массив.
+// Проверка диапазона длительностей выполняется в том же проходе
+class FastCSVDataReader : public IDataReader {
+public:
+    FastCSVDataReader();
+
+    InputData readData(const std::string& inputPath) override;
+    void setThreadCount(int threadCount);
+
+private:
+    int threadCount_;
+
+    void parseDurations(const char* begin, const char* end, InputData& data) const;
+};
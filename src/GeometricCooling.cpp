@@ -0,0 +1,56 @@
+#include "GeometricCooling.h"
+#include <stdexcept>
+
+GeometricCooling::GeometricCooling(double alpha, int patience, int maxReheats)
+    : alpha_(alpha)
+    , patience_(patience)
+    , maxReheats_(maxReheats)
+    , temperature_(0.0)
+    , improvementTemperature_(0.0)
+    , stagnantSteps_(0)
+    , reheatCount_(0) {
+    if (alpha_ <= 0.0 || alpha_ >= 1.0) {
+        throw std::invalid_argument("Alpha must be in (0, 1)");
+    }
+    if (patience_ <= 0 || maxReheats_ < 0) {
+        throw std::invalid_argument("Patience must be positive and reheat count non-negative");
+    }
+}
+
+void GeometricCooling::initialize(double temperature) {
+    temperature_ = temperature;
+    improvementTemperature_ = temperature;
+    stagnantSteps_ = 0;
+    reheatCount_ = 0;
+}
+
+double GeometricCooling::cool(int iteration) {
+    return temperature_;
+}
+
+double GeometricCooling::update(int iteration, const CoolingFeedback& feedback) {
+    if (feedback.improved) {
+        improvementTemperature_ = feedback.temperature;
+        stagnantSteps_ = 0;
+    } else {
+        ++stagnantSteps_;
+    }
+
+    if (stagnantSteps_ >= patience_ && reheatCount_ < maxReheats_ && improvementTemperature_ > temperature_) {
+        temperature_ = improvementTemperature_;
+        stagnantSteps_ = 0;
+        ++reheatCount_;
+        return temperature_;
+    }
+
+    temperature_ *= alpha_;
+    return temperature_;
+}
+
+std::shared_ptr<ICoolingLaw> GeometricCooling::clone() const {
+    return std::make_shared<GeometricCooling>(*this);
+}
+
+int GeometricCooling::getReheatCount() const {
+    return reheatCount_;
+}
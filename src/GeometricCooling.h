@@ -0,0 +1,28 @@
+#pragma once
+
+#include "ICoolingLaw.h"
+
+// Геометрическое охлаждение T' = alpha * T с повторным нагревом: после patience шагов подряд
+// без нового лучшего решения температура возвращается к той, на которой оно было найдено
+// последним (не больше maxReheats раз за прогон). Повторный нагрев срабатывает, только если
+// patience меньше предела шагов без улучшения, по которому останавливается отжиг
+class GeometricCooling : public ICoolingLaw {
+public:
+    explicit GeometricCooling(double alpha = 0.95, int patience = 10, int maxReheats = 3);
+
+    void initialize(double temperature) override;
+    double cool(int iteration) override;
+    double update(int iteration, const CoolingFeedback& feedback) override;
+    std::shared_ptr<ICoolingLaw> clone() const override;
+
+    int getReheatCount() const;
+
+private:
+    double alpha_;
+    int patience_;
+    int maxReheats_;
+    double temperature_;
+    double improvementTemperature_;
+    int stagnantSteps_;
+    int reheatCount_;
+};
@@ -0,0 +1,38 @@
+#include "HuangCooling.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// За один шаг температура падает не больше чем вдвое, в том числе при нулевом разбросе
+constexpr double kMinFactor = 0.5;
+
+}
+
+HuangCooling::HuangCooling(double lambda)
+    : lambda_(lambda)
+    , temperature_(0.0) {
+    if (lambda_ <= 0.0) {
+        throw std::invalid_argument("Lambda must be positive");
+    }
+}
+
+void HuangCooling::initialize(double temperature) {
+    temperature_ = temperature;
+}
+
+double HuangCooling::cool(int iteration) {
+    return temperature_;
+}
+
+double HuangCooling::update(int iteration, const CoolingFeedback& feedback) {
+    double deviation = std::sqrt(feedback.fitnessVariance);
+    double factor = deviation > 0.0 ? std::exp(-lambda_ * temperature_ / deviation) : kMinFactor;
+    temperature_ *= std::max(factor, kMinFactor);
+    return temperature_;
+}
+
+std::shared_ptr<ICoolingLaw> HuangCooling::clone() const {
+    return std::make_shared<HuangCooling>(*this);
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "ICoolingLaw.h"
+
+// Расписание Хуанга, Ромео и Санджованни-Винчентелли: T' = T * exp(-lambda * T / sigma), где sigma -
+// разброс фитнеса на шаге. Пока разброс велик, температура снижается медленно, при малом
+// разбросе (поиск почти заморожен) - быстро; lambda <= 1 задаёт допустимое смещение равновесия
+class HuangCooling : public ICoolingLaw {
+public:
+    explicit HuangCooling(double lambda = 0.7);
+
+    void initialize(double temperature) override;
+    double cool(int iteration) override;
+    double update(int iteration, const CoolingFeedback& feedback) override;
+    std::shared_ptr<ICoolingLaw> clone() const override;
+
+private:
+    double lambda_;
+    double temperature_;
+};
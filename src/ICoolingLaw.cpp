@@ -1 +1,9 @@
-#include "ICoolingLaw.h"
\ No newline at end of file
+#include "ICoolingLaw.h"
+
+double CoolingFeedback::acceptanceRate() const {
+    return proposals > 0 ? static_cast<double>(accepts) / static_cast<double>(proposals) : 0.0;
+}
+
+double ICoolingLaw::update(int iteration, const CoolingFeedback& feedback) {
+    return cool(iteration);
+}
@@ -1,8 +1,37 @@
 #pragma once
 
+#include <memory>
+
+// Наблюдения за завершившимся шагом температуры для адаптивных законов охлаждения
+struct CoolingFeedback {
+    double temperature = 0.0;
+    long long proposals = 0;
+    long long accepts = 0;
+    // Среднее и дисперсия изменения фитнеса по предложениям шага
+    double meanDelta = 0.0;
+    double deltaVariance = 0.0;
+    // Среднее и дисперсия фитнеса текущего решения по итерациям шага
+    double meanFitness = 0.0;
+    double fitnessVariance = 0.0;
+    double currentFitness = 0.0;
+    double bestFitness = 0.0;
+    // На шаге найдено новое лучшее решение; число шагов подряд без улучшения
+    bool improved = false;
+    int stepsWithoutImprovement = 0;
+
+    double acceptanceRate() const;
+};
+
 class ICoolingLaw {
 public:
     virtual ~ICoolingLaw() = default;
     virtual void initialize(double temperature) = 0;
     virtual double cool(int iteration) = 0;
-};
\ No newline at end of file
+
+    // Температура следующего шага по итогам завершившегося; законы с фиксированной кривой
+    // используют только номер итерации (по умолчанию - cool(iteration))
+    virtual double update(int iteration, const CoolingFeedback& feedback);
+
+    // Копия для отдельного потока: адаптивные законы хранят состояние прогона
+    virtual std::shared_ptr<ICoolingLaw> clone() const = 0;
+};
@@ -1 +1,12 @@
-#include "IDataGenerator.h"
\ No newline at end of file
+#include "IDataGenerator.h"
+#include "BinaryDataGenerator.h"
+#include "CSVDataGenerator.h"
+
+std::unique_ptr<IDataGenerator> IDataGenerator::createForPath(const std::string& outputPath) {
+    const std::string binaryExtension = ".bin";
+    if (outputPath.size() >= binaryExtension.size() &&
+        outputPath.compare(outputPath.size() - binaryExtension.size(), binaryExtension.size(), binaryExtension) == 0) {
+        return std::make_unique<BinaryDataGenerator>();
+    }
+    return std::make_unique<CSVDataGenerator>();
+}
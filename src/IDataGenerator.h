@@ -1,12 +1,21 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include <string>
+#include "InstanceGenerator.h"
 
 class IDataGenerator {
 public:
     virtual ~IDataGenerator() = default;
-    virtual void generateData(int jobCount, int processorCount, 
+    virtual void generateData(int jobCount, int processorCount,
                              double minDuration, double maxDuration,
                              const std::string& outputPath) = 0;
-};
\ No newline at end of file
+    virtual void setSeed(std::uint64_t seed) = 0;
+    virtual void setDistribution(InstanceGenerator::Distribution distribution) = 0;
+    virtual void setThreadCount(int threadCount) = 0;
+
+    // Генератор по расширению файла: .bin - двоичный формат, остальное - CSV
+    static std::unique_ptr<IDataGenerator> createForPath(const std::string& outputPath);
+};
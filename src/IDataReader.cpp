@@ -1 +1,12 @@
-#include "IDataReader.h"
\ No newline at end of file
+#include "IDataReader.h"
+#include "BinaryDataReader.h"
+#include "FastCSVDataReader.h"
+
+std::unique_ptr<IDataReader> IDataReader::createForPath(const std::string& inputPath) {
+    const std::string binaryExtension = ".bin";
+    if (inputPath.size() >= binaryExtension.size() &&
+        inputPath.compare(inputPath.size() - binaryExtension.size(), binaryExtension.size(), binaryExtension) == 0) {
+        return std::make_unique<BinaryDataReader>();
+    }
+    return std::make_unique<FastCSVDataReader>();
+}
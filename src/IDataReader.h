@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <vector>
 #include <string>
 
@@ -15,4 +16,7 @@ class IDataReader {
 public:
     virtual ~IDataReader() = default;
     virtual InputData readData(const std::string& inputPath) = 0;
+
+    // Читатель по расширению файла: .bin - двоичный формат, остальное - CSV
+    static std::unique_ptr<IDataReader> createForPath(const std::string& inputPath);
 };
\ No newline at end of file
@@ -1 +1,16 @@
-#include "IMutation.h"
\ No newline at end of file
+#include "IMutation.h"
+#include <stdexcept>
+
+bool IMutation::supportsMoves() const {
+    return false;
+}
+
+SolutionMove IMutation::propose(const ISolution& solution) {
+    throw std::logic_error("Mutation does not support in-place moves");
+}
+
+void IMutation::proposeBatch(const ISolution& solution, SolutionMove* moves, int count) {
+    for (int i = 0; i < count; ++i) {
+        moves[i] = propose(solution);
+    }
+}
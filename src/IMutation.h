@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include "ISolution.h"
 
@@ -7,4 +8,15 @@ class IMutation {
 public:
     virtual ~IMutation() = default;
     virtual std::shared_ptr<ISolution> apply(const std::shared_ptr<ISolution>& solution) = 0;
-};
\ No newline at end of file
+
+    // Копия для отдельного потока; после клонирования её нужно пересеять
+    virtual std::shared_ptr<IMutation> clone() const = 0;
+    virtual void setSeed(std::uint64_t seed) = 0;
+
+    // Протокол без копирования: мутация только описывает изменение,
+    // решение само оценивает его и применяет на месте, если оно принято
+    virtual bool supportsMoves() const;
+    virtual SolutionMove propose(const ISolution& solution);
+    // count независимых предложений для одного и того же решения
+    virtual void proposeBatch(const ISolution& solution, SolutionMove* moves, int count);
+};
@@ -1 +1,52 @@
 #include "ISolution.h"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+ISolution::ISolution()
+    : cachedFitness_(std::numeric_limits<double>::quiet_NaN()) {
+}
+
+ISolution::ISolution(const ISolution& other)
+    : cachedFitness_(other.cachedFitness_.load(std::memory_order_relaxed)) {
+}
+
+ISolution& ISolution::operator=(const ISolution& other) {
+    cachedFitness_.store(other.cachedFitness_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return *this;
+}
+
+double ISolution::fitness() const {
+    double value = cachedFitness_.load(std::memory_order_relaxed);
+    if (std::isnan(value)) {
+        value = evaluate();
+        cachedFitness_.store(value, std::memory_order_relaxed);
+    }
+    return value;
+}
+
+void ISolution::invalidateFitness() {
+    cachedFitness_.store(std::numeric_limits<double>::quiet_NaN(), std::memory_order_relaxed);
+}
+
+bool ISolution::supportsMoves() const {
+    return false;
+}
+
+double ISolution::evaluateMove(const SolutionMove& move) const {
+    throw std::logic_error("Solution does not support in-place moves");
+}
+
+void ISolution::evaluateMoves(const SolutionMove* moves, int count, double* deltas) const {
+    for (int i = 0; i < count; ++i) {
+        deltas[i] = evaluateMove(moves[i]);
+    }
+}
+
+void ISolution::applyMove(const SolutionMove& move) {
+    throw std::logic_error("Solution does not support in-place moves");
+}
+
+int ISolution::distanceTo(const ISolution& other) const {
+    throw std::logic_error("Solution does not support distance computation");
+}
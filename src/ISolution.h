@@ -1,10 +1,43 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 
+// Локальное изменение решения для протокола "предложить/принять" без копирования:
+// Relocate - работа first переходит на процессор second, Swap - работы first и second меняются местами
+struct SolutionMove {
+    enum class Type { Relocate, Swap };
+
+    Type type;
+    int first;
+    int second;
+};
+
 class ISolution {
 public:
+    ISolution();
+    ISolution(const ISolution& other);
+    ISolution& operator=(const ISolution& other);
     virtual ~ISolution() = default;
     virtual double evaluate() const = 0;
     virtual std::shared_ptr<ISolution> clone() const = 0;
-};
\ No newline at end of file
+
+    // Кэшированное значение evaluate(): полный пересчёт только после изменения решения
+    double fitness() const;
+
+    virtual bool supportsMoves() const;
+    virtual double evaluateMove(const SolutionMove& move) const;
+    // Оценка пачки изменений одного и того же решения: deltas[i] = evaluateMove(moves[i])
+    virtual void evaluateMoves(const SolutionMove* moves, int count, double* deltas) const;
+    virtual void applyMove(const SolutionMove& move);
+
+    // Расстояние между решениями для поддержки разнообразия (например, в EliteArchive)
+    virtual int distanceTo(const ISolution& other) const;
+
+protected:
+    void invalidateFitness();
+
+private:
+    // NaN означает "не вычислено"; атомик, т.к. константное решение могут читать несколько потоков
+    mutable std::atomic<double> cachedFitness_;
+};
@@ -0,0 +1,273 @@
+#include "InstanceGenerator.h"
+#include "RandomGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace {
+
+// Размер куска в работах; для семейства hard округляется вверх до кратного числу процессоров
+constexpr size_t kChunkJobs = 1 << 16;
+
+// Параметры семейств в долях диапазона [min, max]
+constexpr double kNormalDeviation = 1.0 / 6.0;
+constexpr double kExponentialScale = 1.0 / 5.0;
+constexpr double kParetoShape = 1.2;
+constexpr double kBimodalLowMean = 0.2;
+constexpr double kBimodalHighMean = 0.8;
+constexpr double kBimodalDeviation = 1.0 / 20.0;
+constexpr int kBalanceRounds = 64;
+
+double standardNormal(RandomGenerator& random) {
+    // Полярный метод Марсальи: не зависит от реализации std::normal_distribution
+    while (true) {
+        double u = 2.0 * random.nextDouble() - 1.0;
+        double v = 2.0 * random.nextDouble() - 1.0;
+        double s = u * u + v * v;
+        if (s > 0.0 && s < 1.0) {
+            return u * std::sqrt(-2.0 * std::log(s) / s);
+        }
+    }
+}
+
+// Нормальное распределение, усечённое отбором до [minDuration, maxDuration]
+double truncatedNormal(RandomGenerator& random, double mean, double deviation, double minDuration, double maxDuration) {
+    while (true) {
+        double value = mean + deviation * standardNormal(random);
+        if (value >= minDuration && value <= maxDuration) {
+            return value;
+        }
+    }
+}
+
+// Доводит сумму группы до target, равномерно распределяя остаток между работами,
+// которые ещё не упёрлись в границу диапазона
+void balanceGroup(double* durations, size_t count, double target, double minDuration, double maxDuration) {
+    for (int round = 0; round < kBalanceRounds; ++round) {
+        double sum = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            sum += durations[i];
+        }
+        double deficit = target - sum;
+        if (std::abs(deficit) <= target * 1e-15) {
+            return;
+        }
+
+        size_t freeCount = 0;
+        for (size_t i = 0; i < count; ++i) {
+            freeCount += deficit > 0 ? durations[i] < maxDuration : durations[i] > minDuration;
+        }
+        if (freeCount == 0) {
+            return;
+        }
+
+        double step = deficit / static_cast<double>(freeCount);
+        for (size_t i = 0; i < count; ++i) {
+            if (deficit > 0 ? durations[i] < maxDuration : durations[i] > minDuration) {
+                durations[i] = std::clamp(durations[i] + step, minDuration, maxDuration);
+            }
+        }
+    }
+}
+
+}
+
+InstanceGenerator::InstanceGenerator()
+    : distribution_(Distribution::Uniform)
+    , seed_(RandomGenerator::clockSeed())
+    , threadCount_(static_cast<int>(std::max(1u, std::thread::hardware_concurrency()))) {
+}
+
+InstanceGenerator::Distribution InstanceGenerator::parseDistribution(const std::string& name) {
+    if (name == "uniform") {
+        return Distribution::Uniform;
+    } else if (name == "normal") {
+        return Distribution::Normal;
+    } else if (name == "exponential") {
+        return Distribution::Exponential;
+    } else if (name == "pareto") {
+        return Distribution::Pareto;
+    } else if (name == "bimodal") {
+        return Distribution::Bimodal;
+    } else if (name == "hard") {
+        return Distribution::Hard;
+    } else {
+        throw std::invalid_argument("Unknown distribution: " + name);
+    }
+}
+
+void InstanceGenerator::setDistribution(Distribution distribution) {
+    distribution_ = distribution;
+}
+
+void InstanceGenerator::setSeed(std::uint64_t seed) {
+    seed_ = seed;
+}
+
+void InstanceGenerator::setThreadCount(int threadCount) {
+    threadCount_ = std::max(1, threadCount);
+}
+
+void InstanceGenerator::generate(int jobCount, int processorCount, double minDuration, double maxDuration,
+                                 const ChunkSerializer& serializer, std::ostream& output) const {
+    generateChunks(jobCount, processorCount, minDuration, maxDuration, serializer, [&output](const std::string& buffer) {
+        output.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        if (!output) {
+            throw std::runtime_error("Cannot write generated instance");
+        }
+    });
+}
+
+InputData InstanceGenerator::generateData(int jobCount, int processorCount, double minDuration, double maxDuration) const {
+    InputData data{processorCount, jobCount, minDuration, maxDuration, {}};
+    data.jobDurations.reserve(static_cast<size_t>(std::max(0, jobCount)));
+    generateChunks(jobCount, processorCount, minDuration, maxDuration,
+        [](size_t, const std::vector<double>& durations, std::string& buffer) {
+            buffer.assign(reinterpret_cast<const char*>(durations.data()), durations.size() * sizeof(double));
+        },
+        [&data](const std::string& buffer) {
+            const double* durations = reinterpret_cast<const double*>(buffer.data());
+            data.jobDurations.insert(data.jobDurations.end(), durations, durations + buffer.size() / sizeof(double));
+        });
+    return data;
+}
+
+void InstanceGenerator::generateChunks(int jobCount, int processorCount, double minDuration, double maxDuration,
+                                       const ChunkSerializer& serializer,
+                                       const std::function<void(const std::string&)>& writer) const {
+    if (jobCount <= 0 || processorCount <= 0) {
+        throw std::invalid_argument("Job count and processor count must be positive");
+    }
+    if (minDuration <= 0 || maxDuration <= minDuration) {
+        throw std::invalid_argument("Invalid duration range");
+    }
+
+    size_t chunkJobs = kChunkJobs;
+    if (distribution_ == Distribution::Hard) {
+        size_t processors = static_cast<size_t>(processorCount);
+        chunkJobs = (chunkJobs + processors - 1) / processors * processors;
+    }
+    size_t totalJobs = static_cast<size_t>(jobCount);
+    size_t chunkCount = (totalJobs + chunkJobs - 1) / chunkJobs;
+
+    // В памяти одновременно не больше пачки кусков; по два куска на поток сглаживают разницу во времени их генерации
+    size_t batchSize = static_cast<size_t>(threadCount_) * 2;
+    std::vector<std::vector<double>> durations(std::min(batchSize, chunkCount));
+    std::vector<std::string> buffers(durations.size());
+    std::vector<std::exception_ptr> errors(durations.size());
+
+    for (size_t batchStart = 0; batchStart < chunkCount; batchStart += batchSize) {
+        size_t batchEnd = std::min(chunkCount, batchStart + batchSize);
+
+        auto worker = [&](size_t first) {
+            for (size_t chunk = batchStart + first; chunk < batchEnd; chunk += static_cast<size_t>(threadCount_)) {
+                size_t slot = chunk - batchStart;
+                try {
+                    size_t chunkSize = std::min(chunkJobs, totalJobs - chunk * chunkJobs);
+                    generateChunk(chunk, chunkSize, processorCount, minDuration, maxDuration, durations[slot]);
+                    buffers[slot].clear();
+                    serializer(chunk, durations[slot], buffers[slot]);
+                } catch (...) {
+                    errors[slot] = std::current_exception();
+                }
+            }
+        };
+
+        size_t workerCount = std::min(static_cast<size_t>(threadCount_), batchEnd - batchStart);
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < workerCount; ++i) {
+            threads.emplace_back(worker, i);
+        }
+        worker(0);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        for (size_t slot = 0; slot < batchEnd - batchStart; ++slot) {
+            if (errors[slot]) {
+                std::rethrow_exception(errors[slot]);
+            }
+            writer(buffers[slot]);
+        }
+    }
+}
+
+void InstanceGenerator::generateChunk(size_t chunkIndex, size_t chunkSize, int processorCount,
+                                      double minDuration, double maxDuration, std::vector<double>& durations) const {
+    RandomGenerator random(RandomGenerator::deriveSeed(seed_, chunkIndex));
+    durations.resize(chunkSize);
+
+    double range = maxDuration - minDuration;
+    double mean = minDuration + range / 2;
+
+    switch (distribution_) {
+        case Distribution::Uniform:
+        case Distribution::Hard:
+            for (double& duration : durations) {
+                duration = minDuration + range * random.nextDouble();
+            }
+            break;
+        case Distribution::Normal:
+            for (double& duration : durations) {
+                duration = truncatedNormal(random, mean, range * kNormalDeviation, minDuration, maxDuration);
+            }
+            break;
+        case Distribution::Exponential: {
+            // Обратная функция экспоненциального распределения, усечённого до диапазона
+            double scale = range * kExponentialScale;
+            double tailMass = std::expm1(-range / scale);
+            for (double& duration : durations) {
+                duration = minDuration - scale * std::log1p(random.nextDouble() * tailMass);
+            }
+            break;
+        }
+        case Distribution::Pareto: {
+            // Ограниченное распределение Парето: тяжёлый хвост редких длинных работ
+            double tailRatio = 1.0 - std::pow(minDuration / maxDuration, kParetoShape);
+            for (double& duration : durations) {
+                duration = minDuration / std::pow(1.0 - random.nextDouble() * tailRatio, 1.0 / kParetoShape);
+            }
+            break;
+        }
+        case Distribution::Bimodal:
+            for (double& duration : durations) {
+                double modeMean = minDuration + range * (random.nextDouble() < 0.5 ? kBimodalLowMean : kBimodalHighMean);
+                duration = truncatedNormal(random, modeMean, range * kBimodalDeviation, minDuration, maxDuration);
+            }
+            break;
+    }
+
+    for (double& duration : durations) {
+        duration = std::clamp(duration, minDuration, maxDuration);
+    }
+
+    if (distribution_ != Distribution::Hard) {
+        return;
+    }
+
+    // Скрытое идеальное разбиение: кусок делится на processorCount групп, сумма каждой группы
+    // доводится до общей цели, затем кусок перемешивается. Полные куски кратны числу процессоров,
+    // поэтому суммы групп по всем кускам совпадают; неравенство возможно только в последнем куске
+    size_t processors = static_cast<size_t>(processorCount);
+    size_t groupSize = chunkSize / processors;
+    size_t largerGroups = chunkSize % processors;
+    if (groupSize > 0) {
+        double target = static_cast<double>(groupSize) * mean;
+        if (largerGroups > 0) {
+            target = std::max(target, static_cast<double>(groupSize + 1) * minDuration);
+        }
+        size_t offset = 0;
+        for (size_t group = 0; group < processors; ++group) {
+            size_t size = groupSize + (group < largerGroups ? 1 : 0);
+            balanceGroup(durations.data() + offset, size, target, minDuration, maxDuration);
+            offset += size;
+        }
+    }
+    for (size_t i = chunkSize; i > 1; --i) {
+        size_t j = static_cast<size_t>(random() % i);
+        std::swap(durations[i - 1], durations[j]);
+    }
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "IDataReader.h"
+
+// Генерация длительностей работ по кускам фиксированного размера. Кусок k строится своим
+// генератором с зерном deriveSeed(seed, k), поэтому результат не зависит от числа потоков.
+// Куски генерируются и сериализуются параллельно, а записываются в поток по порядку,
+// так что в памяти одновременно находится только пачка кусков, а не вся задача
+class InstanceGenerator {
+public:
+    enum class Distribution { Uniform, Normal, Exponential, Pareto, Bimodal, Hard };
+
+    // Сериализует кусок chunkIndex в buffer (buffer очищен перед вызовом)
+    using ChunkSerializer = std::function<void(size_t chunkIndex, const std::vector<double>& durations, std::string& buffer)>;
+
+    InstanceGenerator();
+
+    static Distribution parseDistribution(const std::string& name);
+
+    void setDistribution(Distribution distribution);
+    void setSeed(std::uint64_t seed);
+    void setThreadCount(int threadCount);
+
+    void generate(int jobCount, int processorCount, double minDuration, double maxDuration,
+                  const ChunkSerializer& serializer, std::ostream& output) const;
+    // Те же длительности, что попадают в файл, но сразу в память
+    InputData generateData(int jobCount, int processorCount, double minDuration, double maxDuration) const;
+
+private:
+    Distribution distribution_;
+    std::uint64_t seed_;
+    int threadCount_;
+
+    void generateChunks(int jobCount, int processorCount, double minDuration, double maxDuration,
+                        const ChunkSerializer& serializer, const std::function<void(const std::string&)>& writer) const;
+    void generateChunk(size_t chunkIndex, size_t chunkSize, int processorCount,
+                       double minDuration, double maxDuration, std::vector<double>& durations) const;
+};
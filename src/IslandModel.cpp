@@ -0,0 +1,164 @@
+#include "IslandModel.h"
+#include "RandomGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// Мигрант отправляется раз в интервал миграции, несколько ячеек сглаживают отставание получателя
+constexpr size_t kQueueCapacity = 4;
+
+}
+
+IslandModel::IslandModel(int islandCount, Topology topology, int degree, std::uint64_t seed)
+    : islandCount_(islandCount)
+    , neighbours_(islandCount)
+    , outgoing_(islandCount)
+    , incoming_(islandCount) {
+    if (islandCount_ <= 0) {
+        throw std::invalid_argument("Island count must be positive");
+    }
+    buildLinks(topology, degree, seed);
+}
+
+IslandModel::Topology IslandModel::parseTopology(const std::string& name) {
+    if (name == "ring") {
+        return Topology::Ring;
+    } else if (name == "torus") {
+        return Topology::Torus;
+    } else if (name == "random-k") {
+        return Topology::RandomK;
+    } else if (name == "full") {
+        return Topology::Full;
+    }
+    throw std::invalid_argument("Unknown island topology: " + name);
+}
+
+IslandModel::Policy IslandModel::parsePolicy(const std::string& name) {
+    if (name == "best-worst") {
+        return Policy::BestReplacesWorst;
+    } else if (name == "probabilistic") {
+        return Policy::Probabilistic;
+    } else if (name == "elite") {
+        return Policy::EliteOnly;
+    }
+    throw std::invalid_argument("Unknown migration policy: " + name);
+}
+
+int IslandModel::emigrate(int island, const Migrant& migrant) {
+    int sent = 0;
+    for (MigrationQueue* queue : outgoing_[island]) {
+        if (queue->push(migrant)) {
+            ++sent;
+        }
+    }
+    return sent;
+}
+
+void IslandModel::receive(int island, std::uint64_t epoch, std::vector<Migrant>& migrants) {
+    Migrant migrant;
+    for (MigrationQueue* queue : incoming_[island]) {
+        while (queue->pop(migrant, epoch)) {
+            migrants.push_back(std::move(migrant));
+        }
+    }
+}
+
+const std::vector<int>& IslandModel::neighbours(int island) const {
+    return neighbours_[island];
+}
+
+int IslandModel::islandCount() const {
+    return islandCount_;
+}
+
+int IslandModel::linkCount() const {
+    return static_cast<int>(queues_.size());
+}
+
+void IslandModel::buildLinks(Topology topology, int degree, std::uint64_t seed) {
+    if (islandCount_ == 1) {
+        return;
+    }
+
+    switch (topology) {
+    case Topology::Ring:
+        // Однонаправленное кольцо: лучшие решения обходят все острова за islandCount_ миграций
+        for (int i = 0; i < islandCount_; ++i) {
+            addLink(i, (i + 1) % islandCount_);
+        }
+        break;
+    case Topology::Torus: {
+        // Решётка, близкая к квадратной, с замыканием по краям; связи двунаправленные
+        int columns = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(islandCount_))));
+        int rows = (islandCount_ + columns - 1) / columns;
+        for (int i = 0; i < islandCount_; ++i) {
+            int row = i / columns;
+            int column = i % columns;
+            int right = row * columns + (column + 1) % columns;
+            int down = ((row + 1) % rows) * columns + column;
+            // В неполной последней строке недостающие клетки пропускаются
+            if (right >= islandCount_) {
+                right = row * columns;
+            }
+            if (down >= islandCount_) {
+                down = column;
+            }
+            for (int neighbour : {right, down}) {
+                addLink(i, neighbour);
+                addLink(neighbour, i);
+            }
+        }
+        break;
+    }
+    case Topology::RandomK: {
+        if (degree <= 0) {
+            throw std::invalid_argument("Random-k topology degree must be positive");
+        }
+        int linksPerIsland = std::min(degree, islandCount_ - 1);
+        RandomGenerator generator(seed);
+        std::vector<int> candidates;
+        for (int i = 0; i < islandCount_; ++i) {
+            candidates.clear();
+            for (int j = 0; j < islandCount_; ++j) {
+                if (j != i) {
+                    candidates.push_back(j);
+                }
+            }
+            // Частичное перемешивание Фишера-Йетса: первые linksPerIsland элементов - выборка без повторов
+            for (int k = 0; k < linksPerIsland; ++k) {
+                int remaining = static_cast<int>(candidates.size()) - k;
+                int pick = k + static_cast<int>(generator() % static_cast<std::uint64_t>(remaining));
+                std::swap(candidates[k], candidates[pick]);
+                addLink(i, candidates[k]);
+            }
+        }
+        break;
+    }
+    case Topology::Full:
+        for (int i = 0; i < islandCount_; ++i) {
+            for (int j = 0; j < islandCount_; ++j) {
+                if (i != j) {
+                    addLink(i, j);
+                }
+            }
+        }
+        break;
+    }
+}
+
+void IslandModel::addLink(int from, int to) {
+    if (from == to) {
+        return;
+    }
+    auto& fromNeighbours = neighbours_[from];
+    if (std::find(fromNeighbours.begin(), fromNeighbours.end(), to) != fromNeighbours.end()) {
+        return;
+    }
+
+    queues_.push_back(std::make_unique<MigrationQueue>(kQueueCapacity));
+    fromNeighbours.push_back(to);
+    outgoing_[from].push_back(queues_.back().get());
+    incoming_[to].push_back(queues_.back().get());
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "MigrationQueue.h"
+
+// Островная модель: каждый поток - остров, мигранты идут только по рёбрам топологии,
+// у каждого ориентированного ребра своя очередь. Стоимость обмена пропорциональна
+// степени вершины, а не числу потоков
+class IslandModel {
+public:
+    enum class Topology { Ring, Torus, RandomK, Full };
+    enum class Policy { BestReplacesWorst, Probabilistic, EliteOnly };
+
+    IslandModel(int islandCount, Topology topology, int degree, std::uint64_t seed);
+
+    static Topology parseTopology(const std::string& name);
+    static Policy parsePolicy(const std::string& name);
+
+    // Возвращает число связей, в которые мигрант поместился
+    int emigrate(int island, const Migrant& migrant);
+    // Добавляет в migrants мигрантов острова, отправленных не позже эпохи epoch: быстрый сосед
+    // мог уже отправить следующих, они будут приняты в свою эпоху
+    void receive(int island, std::uint64_t epoch, std::vector<Migrant>& migrants);
+
+    const std::vector<int>& neighbours(int island) const;
+    int islandCount() const;
+    int linkCount() const;
+
+private:
+    int islandCount_;
+    std::vector<std::vector<int>> neighbours_;
+    std::vector<std::vector<MigrationQueue*>> outgoing_;
+    std::vector<std::vector<MigrationQueue*>> incoming_;
+    std::vector<std::unique_ptr<MigrationQueue>> queues_;
+
+    void buildLinks(Topology topology, int degree, std::uint64_t seed);
+    void addLink(int from, int to);
+};
@@ -0,0 +1,52 @@
+#include "LamDelosmeCooling.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+constexpr double kGain = 2.0;
+// За один шаг температура меняется не больше чем вдвое
+constexpr double kMaxFactor = 2.0;
+
+}
+
+LamDelosmeCooling::LamDelosmeCooling(int plannedSteps)
+    : plannedSteps_(plannedSteps)
+    , temperature_(0.0)
+    , step_(0) {
+    if (plannedSteps_ <= 0) {
+        throw std::invalid_argument("Planned step count must be positive");
+    }
+}
+
+void LamDelosmeCooling::initialize(double temperature) {
+    temperature_ = temperature;
+    step_ = 0;
+}
+
+double LamDelosmeCooling::cool(int iteration) {
+    return temperature_;
+}
+
+double LamDelosmeCooling::update(int iteration, const CoolingFeedback& feedback) {
+    ++step_;
+    double progress = static_cast<double>(step_) / plannedSteps_;
+    double factor = std::exp(kGain * (targetAcceptance(progress) - feedback.acceptanceRate()));
+    temperature_ *= std::clamp(factor, 1.0 / kMaxFactor, kMaxFactor);
+    return temperature_;
+}
+
+std::shared_ptr<ICoolingLaw> LamDelosmeCooling::clone() const {
+    return std::make_shared<LamDelosmeCooling>(*this);
+}
+
+double LamDelosmeCooling::targetAcceptance(double progress) const {
+    if (progress < 0.15) {
+        return 0.44 + 0.56 * std::pow(560.0, -progress / 0.15);
+    }
+    if (progress < 0.65) {
+        return 0.44;
+    }
+    return 0.44 * std::pow(440.0, -(progress - 0.65) / 0.35);
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "ICoolingLaw.h"
+
+// Управление по целевой доле принятых предложений (Лам и Делосм, кривая Шварца):
+// в начале цель спадает от 1 к 0.44, в середине прогона держится около 0.44, где сходимость
+// быстрее всего, в конце экспоненциально уходит к нулю. Температура на каждом шаге умножается
+// на exp(gain * (цель - доля)), т.е. остывает, пока поиск горячее цели, и нагревается, пока холоднее
+class LamDelosmeCooling : public ICoolingLaw {
+public:
+    // plannedSteps - ожидаемое число шагов температуры, по нему отсчитывается фаза кривой
+    explicit LamDelosmeCooling(int plannedSteps = 200);
+
+    void initialize(double temperature) override;
+    double cool(int iteration) override;
+    double update(int iteration, const CoolingFeedback& feedback) override;
+    std::shared_ptr<ICoolingLaw> clone() const override;
+
+    double targetAcceptance(double progress) const;
+
+private:
+    int plannedSteps_;
+    double temperature_;
+    int step_;
+};
@@ -11,3 +11,7 @@ double LogarithmicCooling::cool(int iteration) {
 void LogarithmicCooling::initialize(double temperature) {
     temperature_ = temperature;
 }
+
+std::shared_ptr<ICoolingLaw> LogarithmicCooling::clone() const {
+    return std::make_shared<LogarithmicCooling>(*this);
+}
@@ -1,38 +1,269 @@
 #include "Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <utility>
 
-bool Logger::enabled_ = false;
+class Logger::Ring {
+public:
+    static constexpr size_t kCapacity = 8192;
+    static constexpr size_t kMaxMessageLength = 168;
+
+    struct Record {
+        std::int64_t timestamp;
+        LogLevel level;
+        std::uint32_t length;
+        // Длинное сообщение занимает несколько записей подряд; флаг стоит у всех, кроме последней
+        bool continued;
+        char text[kMaxMessageLength];
+    };
+
+    explicit Ring(int threadIndex)
+        : records_(kCapacity)
+        , head_(0)
+        , tail_(0)
+        , dropped_(0)
+        , threadIndex_(threadIndex) {
+    }
+
+    // Вызывается только потоком-владельцем; при переполнении сообщение отбрасывается целиком, а не ждёт.
+    // Все записи сообщения публикуются одним сдвигом head_, поэтому читатель не видит его частями
+    void push(LogLevel level, const std::string& message) {
+        size_t recordCount = std::max<size_t>(1, (message.size() + kMaxMessageLength - 1) / kMaxMessageLength);
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head + recordCount - tail_.load(std::memory_order_acquire) > kCapacity) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        std::int64_t timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        for (size_t i = 0; i < recordCount; ++i) {
+            Record& record = records_[(head + i) & (kCapacity - 1)];
+            size_t offset = i * kMaxMessageLength;
+            record.timestamp = timestamp;
+            record.level = level;
+            record.length = static_cast<std::uint32_t>(std::min(message.size() - offset, kMaxMessageLength));
+            record.continued = i + 1 < recordCount;
+            std::memcpy(record.text, message.data() + offset, record.length);
+        }
+        head_.store(head + recordCount, std::memory_order_release);
+    }
+
+    // Вызывается только фоновым потоком записи
+    template <typename Consumer>
+    size_t drain(Consumer&& consumer) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t head = head_.load(std::memory_order_acquire);
+        for (size_t position = tail; position != head; ++position) {
+            consumer(records_[position & (kCapacity - 1)]);
+        }
+        tail_.store(head, std::memory_order_release);
+        return head - tail;
+    }
+
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    std::uint64_t takeDropped() {
+        return dropped_.exchange(0, std::memory_order_relaxed);
+    }
+
+    int threadIndex() const {
+        return threadIndex_;
+    }
+
+private:
+    std::vector<Record> records_;
+    alignas(64) std::atomic<size_t> head_;
+    alignas(64) std::atomic<size_t> tail_;
+    std::atomic<std::uint64_t> dropped_;
+    int threadIndex_;
+};
+
+std::atomic<int> Logger::minLevel_(static_cast<int>(LogLevel::Off));
+LogLevel Logger::configuredLevel_ = LogLevel::Trace;
 std::ofstream Logger::logFile_;
 std::mutex Logger::logMutex_;
+std::vector<std::shared_ptr<Logger::Ring>> Logger::rings_;
+std::thread Logger::writerThread_;
+std::atomic<bool> Logger::writerRunning_(false);
+
+namespace {
 
-void Logger::initialize(bool enabled, const std::string& filename) {
+// Поток записи должен быть остановлен до разрушения статических членов Logger
+struct LoggerShutdownGuard {
+    ~LoggerShutdownGuard() {
+        Logger::shutdown();
+    }
+} shutdownGuard;
+
+const char* levelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Trace: return "TRACE";
+        case LogLevel::Debug: return "DEBUG";
+        case LogLevel::Info: return "INFO";
+        default: return "";
+    }
+}
+
+// Дата и время до секунды форматируются один раз на секунду, а не на каждую запись
+void appendTimestamp(std::string& text, std::int64_t microseconds) {
+    static std::int64_t cachedSecond = -1;
+    static char cachedPrefix[32];
+
+    std::int64_t second = microseconds / 1000000;
+    if (second != cachedSecond) {
+        std::time_t time = static_cast<std::time_t>(second);
+        std::strftime(cachedPrefix, sizeof(cachedPrefix), "%Y-%m-%d %H:%M:%S", std::localtime(&time));
+        cachedSecond = second;
+    }
+
+    char fraction[16];
+    std::snprintf(fraction, sizeof(fraction), ".%06lld", static_cast<long long>(microseconds % 1000000));
+    text += cachedPrefix;
+    text += fraction;
+}
+
+}
+
+void Logger::initialize(bool enabled, const std::string& filename, LogLevel minLevel) {
     std::lock_guard<std::mutex> lock(logMutex_);
-    enabled_ = enabled;
-    
-    if (enabled_) {
+    configuredLevel_ = minLevel;
+    minLevel_.store(static_cast<int>(enabled ? minLevel : LogLevel::Off), std::memory_order_relaxed);
+
+    if (enabled) {
         logFile_.open(filename, std::ios::out | std::ios::app);
         if (logFile_.is_open()) {
-            logFile_ << "=== Algorithm Log Started ===" << std::endl;
+            logFile_ << "=== Algorithm Log Started ===\n";
+        }
+        if (!writerRunning_.exchange(true)) {
+            writerThread_ = std::thread(&Logger::writerLoop);
         }
     }
 }
 
-void Logger::log(const std::string& message) {
-    if (!enabled_) return;
-    
+void Logger::shutdown() {
+    minLevel_.store(static_cast<int>(LogLevel::Off), std::memory_order_relaxed);
+
+    if (writerRunning_.exchange(false) && writerThread_.joinable()) {
+        writerThread_.join();
+    }
+
+    drainRings();
+
     std::lock_guard<std::mutex> lock(logMutex_);
-    
-    // Вывод в консоль
-    std::cout << "[LOG] " << message << std::endl;
-    
-    // Запись в файл
     if (logFile_.is_open()) {
-        auto now = std::chrono::system_clock::now();
-        auto time = std::chrono::system_clock::to_time_t(now);
-        logFile_ << "[" << std::ctime(&time) << "] " << message << std::endl;
+        logFile_.flush();
+        logFile_.close();
     }
 }
 
+void Logger::log(const std::string& message) {
+    if (!isEnabled(LogLevel::Info)) return;
+    write(LogLevel::Info, message);
+}
+
+void Logger::write(LogLevel level, const std::string& message) {
+    localRing().push(level, message);
+}
+
 void Logger::setEnabled(bool enabled) {
     std::lock_guard<std::mutex> lock(logMutex_);
-    enabled_ = enabled;
-}
\ No newline at end of file
+    minLevel_.store(static_cast<int>(enabled ? configuredLevel_ : LogLevel::Off), std::memory_order_relaxed);
+}
+
+Logger::Ring& Logger::localRing() {
+    thread_local std::shared_ptr<Ring> ring;
+    if (!ring) {
+        std::lock_guard<std::mutex> lock(logMutex_);
+        static int nextThreadIndex = 0;
+        ring = std::make_shared<Ring>(nextThreadIndex++);
+        rings_.push_back(ring);
+    }
+    return *ring;
+}
+
+void Logger::writerLoop() {
+    while (writerRunning_.load(std::memory_order_relaxed)) {
+        if (drainRings() == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+size_t Logger::drainRings() {
+    std::lock_guard<std::mutex> lock(logMutex_);
+
+    struct Entry {
+        int threadIndex;
+        Ring::Record record;
+    };
+    std::vector<Entry> batch;
+    std::vector<std::pair<int, std::uint64_t>> drops;
+
+    for (auto& ring : rings_) {
+        int threadIndex = ring->threadIndex();
+        ring->drain([&](const Ring::Record& record) {
+            batch.push_back(Entry{threadIndex, record});
+        });
+
+        std::uint64_t dropped = ring->takeDropped();
+        if (dropped > 0) {
+            drops.emplace_back(threadIndex, dropped);
+        }
+    }
+
+    // Буферы завершившихся потоков больше никто не пополнит
+    rings_.erase(std::remove_if(rings_.begin(), rings_.end(), [](const std::shared_ptr<Ring>& ring) {
+        return ring.use_count() == 1 && ring->empty();
+    }), rings_.end());
+
+    if (batch.empty() && drops.empty()) {
+        return 0;
+    }
+
+    // Записи разных потоков в одной пачке упорядочиваются по времени; части одного сообщения
+    // имеют общую метку и идут подряд, устойчивая сортировка их не разделяет
+    std::stable_sort(batch.begin(), batch.end(), [](const Entry& first, const Entry& second) {
+        return first.record.timestamp < second.record.timestamp;
+    });
+
+    if (logFile_.is_open()) {
+        std::string text;
+        text.reserve(batch.size() * 128);
+        bool continuation = false;
+        for (const auto& entry : batch) {
+            if (continuation) {
+                text.append(entry.record.text, entry.record.length);
+                continuation = entry.record.continued;
+                if (!continuation) {
+                    text += '\n';
+                }
+                continue;
+            }
+            text += '[';
+            appendTimestamp(text, entry.record.timestamp);
+            text += "] [T";
+            text += std::to_string(entry.threadIndex);
+            text += "] [";
+            text += levelName(entry.record.level);
+            text += "] ";
+            text.append(entry.record.text, entry.record.length);
+            continuation = entry.record.continued;
+            if (!continuation) {
+                text += '\n';
+            }
+        }
+        for (const auto& drop : drops) {
+            text += "[T" + std::to_string(drop.first) + "] dropped " +
+                    std::to_string(drop.second) + " messages (buffer full)\n";
+        }
+        logFile_.write(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+    return batch.size();
+}
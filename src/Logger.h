@@ -1,18 +1,60 @@
 #pragma once
 
-#include <string>
+#include <atomic>
 #include <fstream>
-#include <iostream>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class LogLevel { Trace = 0, Debug = 1, Info = 2, Off = 3 };
+
+// Уровни ниже LOG_COMPILED_LEVEL вырезаются при компиляции вместе с формированием сообщения
+#ifndef LOG_COMPILED_LEVEL
+#define LOG_COMPILED_LEVEL 0
+#endif
+
+// Сообщение формируется только если уровень включён: выключенный лог стоит одну проверку
+#define LOG_AT(level, message)                                                   \
+    do {                                                                         \
+        if (static_cast<int>(level) >= LOG_COMPILED_LEVEL && Logger::isEnabled(level)) { \
+            Logger::write(level, message);                                       \
+        }                                                                        \
+    } while (0)
 
+#define LOG_TRACE(message) LOG_AT(LogLevel::Trace, message)
+#define LOG_DEBUG(message) LOG_AT(LogLevel::Debug, message)
+#define LOG_INFO(message) LOG_AT(LogLevel::Info, message)
+
+// Асинхронный логгер: каждый поток пишет в свой кольцевой буфер без блокировок,
+// фоновый поток собирает записи пачками и пишет их в файл
 class Logger {
 public:
-    static void initialize(bool enabled, const std::string& filename = "algorithm.log");
+    static void initialize(bool enabled, const std::string& filename = "algorithm.log",
+                           LogLevel minLevel = LogLevel::Trace);
+    static void shutdown();
+
     static void log(const std::string& message);
+    static void write(LogLevel level, const std::string& message);
     static void setEnabled(bool enabled);
 
+    static bool isEnabled(LogLevel level) {
+        return static_cast<int>(level) >= minLevel_.load(std::memory_order_relaxed);
+    }
+
 private:
-    static bool enabled_;
+    class Ring;
+
+    static std::atomic<int> minLevel_;
+    static LogLevel configuredLevel_;
     static std::ofstream logFile_;
     static std::mutex logMutex_;
-};
\ No newline at end of file
+    static std::vector<std::shared_ptr<Ring>> rings_;
+    static std::thread writerThread_;
+    static std::atomic<bool> writerRunning_;
+
+    static Ring& localRing();
+    static void writerLoop();
+    static size_t drainRings();
+};
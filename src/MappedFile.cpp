@@ -0,0 +1,53 @@
+#include "MappedFile.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string& path)
+    : address_(nullptr)
+    , size_(0) {
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        throw std::runtime_error("Cannot open file: " + path + ": " + std::strerror(errno));
+    }
+
+    struct stat status;
+    if (::fstat(descriptor, &status) != 0) {
+        int error = errno;
+        ::close(descriptor);
+        throw std::runtime_error("Cannot stat file: " + path + ": " + std::strerror(error));
+    }
+    size_ = static_cast<size_t>(status.st_size);
+
+    if (size_ > 0) {
+        address_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (address_ == MAP_FAILED) {
+            int error = errno;
+            address_ = nullptr;
+            ::close(descriptor);
+            throw std::runtime_error("Cannot map file: " + path + ": " + std::strerror(error));
+        }
+        // Файл читается один раз подряд: ядро может читать вперёд агрессивнее
+        ::madvise(address_, size_, MADV_SEQUENTIAL);
+    }
+    // Отображение не зависит от дескриптора
+    ::close(descriptor);
+}
+
+MappedFile::~MappedFile() {
+    if (address_) {
+        ::munmap(address_, size_);
+    }
+}
+
+const char* MappedFile::data() const {
+    return static_cast<const char*>(address_);
+}
+
+size_t MappedFile::size() const {
+    return size_;
+}
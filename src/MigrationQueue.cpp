@@ -0,0 +1,39 @@
+#include "MigrationQueue.h"
+#include <stdexcept>
+
+MigrationQueue::MigrationQueue(size_t capacity)
+    : head_(0)
+    , tail_(0) {
+    if (capacity == 0) {
+        throw std::invalid_argument("Migration queue capacity must be positive");
+    }
+    // Ёмкость округляется до степени двойки, чтобы индекс считался маской
+    size_t roundedCapacity = 1;
+    while (roundedCapacity < capacity) {
+        roundedCapacity *= 2;
+    }
+    slots_.resize(roundedCapacity);
+    mask_ = roundedCapacity - 1;
+}
+
+bool MigrationQueue::push(const Migrant& migrant) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) >= slots_.size()) {
+        return false;
+    }
+    slots_[head & mask_] = migrant;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+bool MigrationQueue::pop(Migrant& migrant, std::uint64_t maxEpoch) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail == head_.load(std::memory_order_acquire) || slots_[tail & mask_].epoch > maxEpoch) {
+        return false;
+    }
+    // Слот освобождается сразу, чтобы очередь не продлевала жизнь старых решений
+    migrant = std::move(slots_[tail & mask_]);
+    slots_[tail & mask_] = Migrant();
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "ISolution.h"
+
+// Мигрант передаётся по ссылке на неизменяемое решение: получатель сам делает копию.
+// epoch - номер миграции у отправителя
+struct Migrant {
+    std::shared_ptr<ISolution> solution;
+    double fitness = 0.0;
+    std::uint64_t epoch = 0;
+};
+
+// Очередь одной связи острова-отправителя с островом-получателем: один писатель,
+// один читатель, без блокировок. При переполнении новый мигрант отбрасывается
+class MigrationQueue {
+public:
+    explicit MigrationQueue(size_t capacity);
+    MigrationQueue(const MigrationQueue&) = delete;
+    MigrationQueue& operator=(const MigrationQueue&) = delete;
+
+    // Только поток-отправитель
+    bool push(const Migrant& migrant);
+    // Только поток-получатель; мигранты из эпох позже maxEpoch остаются в очереди
+    bool pop(Migrant& migrant, std::uint64_t maxEpoch);
+
+private:
+    std::vector<Migrant> slots_;
+    size_t mask_;
+    alignas(64) std::atomic<size_t> head_;
+    alignas(64) std::atomic<size_t> tail_;
+};
@@ -1,8 +1,11 @@
 #include "ParallelSimulatedAnnealing.h"
 #include "Logger.h"
 #include <chrono>
+#include <fstream>
 #include <random>
 #include <algorithm>
+#include <cmath>
+#include <stdexcept>
 #include <thread>
 
 ParallelSimulatedAnnealing::ParallelSimulatedAnnealing(int numThreads)
@@ -11,16 +14,50 @@ ParallelSimulatedAnnealing::ParallelSimulatedAnnealing(int numThreads)
     , shouldStop_(false)
     , iterationsWithoutImprovement_(0)
     , globalBestFitness_(std::numeric_limits<double>::max())
+    , asyncExchange_(false)
+    , islandsEnabled_(false)
+    , islandTopology_(IslandModel::Topology::Ring)
+    , migrationPolicy_(IslandModel::Policy::BestReplacesWorst)
+    , islandDegree_(2)
+    , migrationInterval_(1)
     , initialTemperature_(0.0)
     , iterationsPerTemperature_(0)
-    , maxIterationsWithoutImprovement_(0) {
+    , maxIterationsWithoutImprovement_(0)
+    , maxIterationsWithoutImprovementGlobal_(0)
+    , seed_(RandomGenerator::clockSeed())
+    , eliteArchiveSize_(0)
+    , eliteMinDistance_(1)
+    , epochIterations_(10000)
+    , batchSize_(1)
+    , batchSelection_(SimulatedAnnealing::BatchSelection::FirstAccepted)
+    , rejectionFreeSampleSize_(0)
+    , rejectionFreeThreshold_(0.01)
+    , stagnationStrategy_(SimulatedAnnealing::StagnationStrategy::Stop)
+    , maxRestarts_(0)
+    , reheatFraction_(1.0)
+    , kickMoves_(0)
+    , timeLimit_(0.0)
+    , targetFitness_(std::numeric_limits<double>::lowest())
+    , interruptFlag_(nullptr)
+    , deadline_(std::chrono::steady_clock::time_point::max())
+    , reportedFitness_(std::numeric_limits<double>::max())
+    , exchangeCount_(0)
+    , globalImprovementCount_(0)
+    , snapshotPublishCount_(0)
+    , snapshotImportCount_(0)
+    , migrationsSentCount_(0)
+    , migrationsAcceptedCount_(0)
+    , migrationsDroppedCount_(0)
+    , isRunning_(false)
+    , metricsSampleInterval_(1000)
+    , samplerRunning_(false) {
     
     if (numThreads_ <= 0) {
         numThreads_ = std::thread::hardware_concurrency();
         if (numThreads_ == 0) numThreads_ = 1;
     }
     
-    Logger::log("ParallelSimulatedAnnealing created with " + std::to_string(numThreads_) + " threads");
+    LOG_INFO("ParallelSimulatedAnnealing created with " + std::to_string(numThreads_) + " threads");
 }
 
 ParallelSimulatedAnnealing::~ParallelSimulatedAnnealing() {
@@ -29,7 +66,7 @@ ParallelSimulatedAnnealing::~ParallelSimulatedAnnealing() {
 
 void ParallelSimulatedAnnealing::setInitialSolution(const std::shared_ptr<ISolution>& solution) {
     initialSolutionTemplate_ = solution;
-    Logger::log("Initial solution set for parallel algorithm");
+    LOG_INFO("Initial solution set for parallel algorithm");
 }
 
 void ParallelSimulatedAnnealing::setMutation(const std::shared_ptr<IMutation>& mutation) {
@@ -42,88 +79,260 @@ void ParallelSimulatedAnnealing::setCoolingLaw(const std::shared_ptr<ICoolingLaw
 
 void ParallelSimulatedAnnealing::setInitialTemperature(double temperature) {
     initialTemperature_ = temperature;
-    Logger::log("Parallel initial temperature set to: " + std::to_string(temperature));
+    LOG_INFO("Parallel initial temperature set to: " + std::to_string(temperature));
 }
 
 void ParallelSimulatedAnnealing::setIterationsPerTemperature(int iterations) {
     iterationsPerTemperature_ = iterations;
-    Logger::log("Parallel iterations per temperature set to: " + std::to_string(iterations));
+    LOG_INFO("Parallel iterations per temperature set to: " + std::to_string(iterations));
 }
 
 void ParallelSimulatedAnnealing::setMaxIterationsWithoutImprovement(int iterations) {
     maxIterationsWithoutImprovement_ = iterations;
-    Logger::log("Parallel max iterations without improvement set to: " + std::to_string(iterations));
+    LOG_INFO("Parallel max iterations without improvement set to: " + std::to_string(iterations));
 }
 
 void ParallelSimulatedAnnealing::setMaxIterationsWithoutImprovementGlobal(int iterations) {
     maxIterationsWithoutImprovementGlobal_ = iterations;
-    Logger::log("Parallel max iterations without improvement global set to: " + std::to_string(iterations));
+    LOG_INFO("Parallel max iterations without improvement global set to: " + std::to_string(iterations));
 }
 
 void ParallelSimulatedAnnealing::setExchangeInterval(int interval) {
     exchangeInterval_ = interval;
-    Logger::log("Exchange interval set to: " + std::to_string(interval));
+    LOG_INFO("Exchange interval set to: " + std::to_string(interval));
+}
+
+void ParallelSimulatedAnnealing::setSeed(std::uint64_t seed) {
+    seed_ = seed;
+    LOG_INFO("Parallel random seed set to: " + std::to_string(seed));
+}
+
+void ParallelSimulatedAnnealing::setEliteArchive(int size, int minDistance) {
+    eliteArchiveSize_ = size;
+    eliteMinDistance_ = minDistance;
+    LOG_INFO("Elite archive set: size=" + std::to_string(size) +
+             ", min_distance=" + std::to_string(minDistance));
+}
+
+void ParallelSimulatedAnnealing::setMetricsSampling(const std::string& path, int intervalMilliseconds) {
+    metricsSamplePath_ = path;
+    metricsSampleInterval_ = intervalMilliseconds > 0 ? intervalMilliseconds : 1000;
+    LOG_INFO("Metrics sampling set: path=" + path + ", interval_ms=" + std::to_string(metricsSampleInterval_));
+}
+
+void ParallelSimulatedAnnealing::setEpochIterations(long long iterations) {
+    if (iterations <= 0) {
+        throw std::invalid_argument("Epoch iterations must be positive");
+    }
+    epochIterations_ = iterations;
+    LOG_INFO("Epoch iterations set to: " + std::to_string(iterations));
+}
+
+void ParallelSimulatedAnnealing::setAsyncExchange(bool enabled) {
+    asyncExchange_ = enabled;
+    LOG_INFO("Async exchange set to: " + std::to_string(enabled));
+}
+
+void ParallelSimulatedAnnealing::setBatchProposals(int batchSize, SimulatedAnnealing::BatchSelection selection) {
+    if (batchSize <= 0) {
+        throw std::invalid_argument("Batch size must be positive");
+    }
+    batchSize_ = batchSize;
+    batchSelection_ = selection;
+    LOG_INFO("Batch proposals set to: " + std::to_string(batchSize));
+}
+
+void ParallelSimulatedAnnealing::setRejectionFree(int sampleSize, double acceptanceThreshold) {
+    if (sampleSize < 0) {
+        throw std::invalid_argument("Sample size must be non-negative");
+    }
+    if (sampleSize > 0 && (acceptanceThreshold <= 0.0 || acceptanceThreshold > 1.0)) {
+        throw std::invalid_argument("Acceptance threshold must be in (0, 1]");
+    }
+    rejectionFreeSampleSize_ = sampleSize;
+    rejectionFreeThreshold_ = acceptanceThreshold;
+    LOG_INFO("Rejection-free sample size set to: " + std::to_string(sampleSize));
+}
+
+void ParallelSimulatedAnnealing::setStagnationStrategy(SimulatedAnnealing::StagnationStrategy strategy, int maxRestarts,
+                                                       double reheatFraction, int kickMoves) {
+    if (maxRestarts < 0) {
+        throw std::invalid_argument("Restart count must be non-negative");
+    }
+    if (reheatFraction <= 0.0) {
+        throw std::invalid_argument("Reheat fraction must be positive");
+    }
+    if (strategy == SimulatedAnnealing::StagnationStrategy::Kick && kickMoves <= 0) {
+        throw std::invalid_argument("Kick moves must be positive");
+    }
+    stagnationStrategy_ = strategy;
+    maxRestarts_ = maxRestarts;
+    reheatFraction_ = reheatFraction;
+    kickMoves_ = kickMoves;
+    LOG_INFO("Stagnation strategy set: max_restarts=" + std::to_string(maxRestarts));
+}
+
+void ParallelSimulatedAnnealing::setIslandModel(IslandModel::Topology topology, IslandModel::Policy policy,
+                                                int degree, int migrationInterval) {
+    if (migrationInterval <= 0) {
+        throw std::invalid_argument("Migration interval must be positive");
+    }
+    islandsEnabled_ = true;
+    islandTopology_ = topology;
+    migrationPolicy_ = policy;
+    islandDegree_ = degree;
+    migrationInterval_ = migrationInterval;
+    LOG_INFO("Island model set: degree=" + std::to_string(degree) +
+             ", migration_interval=" + std::to_string(migrationInterval));
+}
+
+void ParallelSimulatedAnnealing::setTimeLimit(double seconds) {
+    if (seconds < 0.0) {
+        throw std::invalid_argument("Time limit must be non-negative");
+    }
+    timeLimit_ = seconds;
+    LOG_INFO("Parallel time limit set to: " + std::to_string(seconds) + " s");
+}
+
+void ParallelSimulatedAnnealing::setTargetFitness(double fitness) {
+    targetFitness_ = fitness;
+    LOG_INFO("Parallel target fitness set to: " + std::to_string(fitness));
+}
+
+void ParallelSimulatedAnnealing::setInterruptFlag(const std::atomic<bool>* flag) {
+    interruptFlag_ = flag;
+}
+
+void ParallelSimulatedAnnealing::setImprovementCallback(ImprovementCallback callback) {
+    improvementCallback_ = std::move(callback);
+}
+
+ParallelMetrics ParallelSimulatedAnnealing::getMetrics() const {
+    ParallelMetrics metrics;
+    for (const auto& threadData : threads_) {
+        AnnealingMetrics threadMetrics = threadData.algorithm ? threadData.algorithm->getMetrics() : AnnealingMetrics();
+        metrics.total.add(threadMetrics);
+        metrics.threads.push_back(threadMetrics);
+    }
+    metrics.exchanges = exchangeCount_.load(std::memory_order_relaxed);
+    metrics.globalImprovements = globalImprovementCount_.load(std::memory_order_relaxed);
+    metrics.snapshotPublishes = snapshotPublishCount_.load(std::memory_order_relaxed);
+    metrics.snapshotImports = snapshotImportCount_.load(std::memory_order_relaxed);
+    metrics.migrationsSent = migrationsSentCount_.load(std::memory_order_relaxed);
+    metrics.migrationsAccepted = migrationsAcceptedCount_.load(std::memory_order_relaxed);
+    metrics.migrationsDropped = migrationsDroppedCount_.load(std::memory_order_relaxed);
+    
+    auto end = isRunning_ ? std::chrono::steady_clock::now() : runEnd_;
+    metrics.wallSeconds = std::chrono::duration<double>(end - runStart_).count();
+    return metrics;
 }
 
 std::shared_ptr<ISolution> ParallelSimulatedAnnealing::run() {
     if (!initialSolutionTemplate_ || !mutation_ || !coolingLaw_) {
-        Logger::log("ERROR: Parallel algorithm not properly initialized");
+        LOG_INFO("ERROR: Parallel algorithm not properly initialized");
         return nullptr;
     }
     
     globalBestSolution_ = initialSolutionTemplate_->clone();
-    globalBestFitness_ = globalBestSolution_->evaluate();
+    globalBestFitness_ = globalBestSolution_->fitness();
+    double initialFitness = globalBestFitness_;
+    
+    eliteArchive_.reset();
+    if (eliteArchiveSize_ > 0) {
+        eliteArchive_ = std::make_unique<EliteArchive>(eliteArchiveSize_, eliteMinDistance_);
+        eliteArchive_->offer(globalBestSolution_, globalBestFitness_);
+    }
     
     iterationsWithoutImprovement_ = 0;
     shouldStop_ = false;
+    exchangeCount_ = 0;
+    globalImprovementCount_ = 0;
+    snapshotPublishCount_ = 0;
+    snapshotImportCount_ = 0;
+    migrationsSentCount_ = 0;
+    migrationsAcceptedCount_ = 0;
+    migrationsDroppedCount_ = 0;
     
-    Logger::log("Parallel algorithm STARTED: threads=" + std::to_string(numThreads_) +
-                ", initial_fitness=" + std::to_string(globalBestFitness_) +
-                ", exchange_interval=" + std::to_string(exchangeInterval_));
+    islandModel_.reset();
+    if (islandsEnabled_) {
+        islandModel_ = std::make_unique<IslandModel>(numThreads_, islandTopology_, islandDegree_,
+                                                     RandomGenerator::deriveSeed(seed_, 3 * static_cast<std::uint64_t>(numThreads_)));
+        LOG_INFO("Island model links: " + std::to_string(islandModel_->linkCount()));
+    }
+    globalSnapshot_.publish(globalBestSolution_, globalBestFitness_);
+    reportedFitness_ = initialFitness;
+    runStart_ = std::chrono::steady_clock::now();
+    // Срок общий для всех потоков и всех их перезапусков
+    deadline_ = std::chrono::steady_clock::time_point::max();
+    if (timeLimit_ > 0.0) {
+        deadline_ = runStart_ + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(timeLimit_));
+    }
+    isRunning_ = true;
+    
+    LOG_INFO("Parallel algorithm STARTED: threads=" + std::to_string(numThreads_) +
+             ", initial_fitness=" + std::to_string(globalBestFitness_) +
+             ", exchange_interval=" + std::to_string(exchangeInterval_));
+    
+    barrier_.reset(numThreads_);
     
     initializeThreads();
     
+    if (!metricsSamplePath_.empty()) {
+        samplerRunning_ = true;
+        samplerThread_ = std::thread(&ParallelSimulatedAnnealing::samplerThread, this);
+    }
+    
     int globalCycle = 0;
     
-    while (iterationsWithoutImprovement_ < maxIterationsWithoutImprovementGlobal_ && !shouldStop_) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    while (!shouldStop_) {
+        if (!barrier_.waitForAll()) {
+            if (barrier_.activeCount() == 0) {
+                LOG_INFO("All threads finished, stopping parallel algorithm");
+            }
+            break;
+        }
         
+        // Все активные потоки стоят на барьере, обмен не конкурирует с отжигом
         bool improved = exchangeSolutions();
         
         if (improved) {
             iterationsWithoutImprovement_ = 0;
-            Logger::log("Global improvement found in cycle " + std::to_string(globalCycle));
+            LOG_DEBUG("Global improvement found in epoch " + std::to_string(globalCycle));
         } else {
             iterationsWithoutImprovement_++;
-            Logger::log("No global improvement in cycle " + std::to_string(globalCycle) +
-                        ", count=" + std::to_string(iterationsWithoutImprovement_));
+            LOG_DEBUG("No global improvement in epoch " + std::to_string(globalCycle) +
+                      ", count=" + std::to_string(iterationsWithoutImprovement_));
         }
         
         globalCycle++;
         
-        if (globalCycle % 10 == 0) {
-            bool anyThreadRunning = false;
-            for (auto& threadData : threads_) {
-                if (threadData.algorithm && threadData.algorithm->isRunning()) {
-                    anyThreadRunning = true;
-                    break;
-                }
-            }
-            
-            if (!anyThreadRunning) {
-                Logger::log("All threads finished, stopping parallel algorithm");
-                break;
-            }
+        if (iterationsWithoutImprovement_ >= maxIterationsWithoutImprovementGlobal_) {
+            break;
         }
+        
+        barrier_.release();
     }
     
     stop();
     
     exchangeSolutions();
     
-    Logger::log("Parallel algorithm FINISHED: global_cycles=" + std::to_string(globalCycle) +
-                ", final_fitness=" + std::to_string(globalBestFitness_) +
-                ", total_improvement=" + std::to_string(initialSolutionTemplate_->evaluate() - globalBestFitness_));
+    runEnd_ = std::chrono::steady_clock::now();
+    isRunning_ = false;
+    
+    if (samplerThread_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(samplerMutex_);
+            samplerRunning_ = false;
+        }
+        samplerCondition_.notify_all();
+        samplerThread_.join();
+    }
+    
+    LOG_INFO("Parallel algorithm FINISHED: global_cycles=" + std::to_string(globalCycle) +
+             ", final_fitness=" + std::to_string(globalBestFitness_) +
+             ", total_improvement=" + std::to_string(initialFitness - globalBestFitness_));
     
     return globalBestSolution_;
 }
@@ -131,122 +340,317 @@ std::shared_ptr<ISolution> ParallelSimulatedAnnealing::run() {
 void ParallelSimulatedAnnealing::workerThread(int threadId) {
     auto& threadData = threads_[threadId];
     
-    Logger::log("Worker thread " + std::to_string(threadId) + " started");
+    LOG_INFO("Worker thread " + std::to_string(threadId) + " started");
     
-    threadData.algorithm = std::make_unique<SimulatedAnnealing>();
-    threadData.algorithm->setInitialSolution(createThreadSpecificSolution());
-    threadData.algorithm->setMutation(mutation_);
-    threadData.algorithm->setCoolingLaw(coolingLaw_);
-    threadData.algorithm->setInitialTemperature(initialTemperature_);
-    threadData.algorithm->setIterationsPerTemperature(iterationsPerTemperature_);
-    threadData.algorithm->setMaxIterationsWithoutImprovement(maxIterationsWithoutImprovement_);
+    // Собственные генераторы потока: общая мутация не разделяется между потоками,
+    // а зерна выводятся из главного, поэтому повторный запуск воспроизводим
+    std::uint64_t stream = 3 * static_cast<std::uint64_t>(threadId);
+    auto mutation = mutation_->clone();
+    mutation->setSeed(RandomGenerator::deriveSeed(seed_, stream));
+    RandomGenerator restartGenerator(RandomGenerator::deriveSeed(seed_, stream + 2));
+    
+    // Кроме самого потока алгоритм трогают только getMetrics() и stop(), оба через атомарные поля
+    std::uint64_t seenGlobalVersion = globalSnapshot_.version();
+    auto& algorithm = *threadData.algorithm;
+    algorithm.setSeed(RandomGenerator::deriveSeed(seed_, stream + 1));
+    algorithm.setInitialSolution(createThreadSpecificSolution(mutation));
+    algorithm.setMutation(mutation);
+    algorithm.setCoolingLaw(coolingLaw_->clone());
+    algorithm.setInitialTemperature(initialTemperature_);
+    algorithm.setIterationsPerTemperature(iterationsPerTemperature_);
+    algorithm.setMaxIterationsWithoutImprovement(maxIterationsWithoutImprovement_);
+    algorithm.setBatchProposals(batchSize_, batchSelection_);
+    algorithm.setRejectionFree(rejectionFreeSampleSize_, rejectionFreeThreshold_);
+    algorithm.setStagnationStrategy(stagnationStrategy_, maxRestarts_, reheatFraction_, kickMoves_);
+    algorithm.setDeadline(deadline_);
+    algorithm.setTargetFitness(targetFitness_);
+    algorithm.setInterruptFlag(interruptFlag_);
+    algorithm.setImprovementCallback([this, &threadData, threadId](const std::shared_ptr<ISolution>& solution, double fitness) {
+        threadData.best.publishIfBetter(solution, fitness);
+        if (improvementCallback_) {
+            reportImprovement(threadId, solution, fitness);
+        }
+        if (asyncExchange_ && globalSnapshot_.publishIfBetter(solution, fitness)) {
+            snapshotPublishCount_.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    if (asyncExchange_) {
+        algorithm.setExternalSolutionSource([this, &seenGlobalVersion]() {
+            return takeGlobalUpdate(seenGlobalVersion);
+        });
+    }
+    // Архив меняется только на барьере, а между барьерами выбор из него идёт под его мьютексом;
+    // снимок глобального лучшего решения читается без блокировок
+    algorithm.setEliteSource([this, &restartGenerator]() -> std::shared_ptr<ISolution> {
+        if (eliteArchive_) {
+            return eliteArchive_->select(restartGenerator);
+        }
+        auto entry = globalSnapshot_.load();
+        return entry ? entry->solution : nullptr;
+    });
+    algorithm.start();
     
-    int localIterations = 0;
+    int completedRuns = 0;
+    std::uint64_t epoch = 0;
+    std::uint64_t epochIndex = 0;
+    double lastEmigrantFitness = std::numeric_limits<double>::max();
+    std::vector<Migrant> immigrants;
     
-    while (!shouldStop_ && localIterations < exchangeInterval_) {
-        std::shared_ptr<ISolution> localBest = nullptr;
-        {
-            std::lock_guard<std::mutex> lock(threadData.solutionMutex);
-            localBest = threadData.algorithm->run();
+    while (!shouldStop_) {
+        bool runFinished = algorithm.advance(epochIterations_);
+        
+        // Срок, цель и прерывание завершают весь алгоритм, а не только прогон потока
+        auto reason = algorithm.getStopReason();
+        if (reason == SimulatedAnnealing::StopReason::Deadline || reason == SimulatedAnnealing::StopReason::TargetReached ||
+            reason == SimulatedAnnealing::StopReason::Interrupted) {
+            requestStop();
+            break;
         }
         
-        if (localBest) {
-            std::lock_guard<std::mutex> lock(threadData.solutionMutex);
-
-            double localFitness = localBest->evaluate();
-            threadData.bestSolution = localBest;
-            threadData.bestFitness = localFitness;
-            
-            Logger::log("Thread " + std::to_string(threadId) + " local best: " + std::to_string(localFitness));
+        if (runFinished) {
+            threadData.runBestSolution = algorithm.getBestSolution();
+            threadData.runBestFitness = algorithm.getBestFitness();
+            LOG_INFO("Thread " + std::to_string(threadId) + " local best: " + std::to_string(threadData.runBestFitness));
+            ++completedRuns;
         }
         
-        ++localIterations;
+        // Мигранты отправляются до барьера и принимаются после него, с отметкой эпохи,
+        // поэтому принятые мигранты не зависят от планировщика
+        bool migrationEpoch = islandModel_ && ++epochIndex % migrationInterval_ == 0;
+        if (migrationEpoch) {
+            emigrate(threadId, epochIndex, lastEmigrantFitness);
+        }
         
-        if (shouldStop_) {
+        bool done = runFinished && completedRuns >= exchangeInterval_;
+        if (done || !barrier_.arriveAndWait(epoch)) {
             break;
         }
         
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        if (migrationEpoch) {
+            immigrate(threadId, epochIndex, immigrants, restartGenerator);
+        }
+        
+        // Без архива и островов все потоки продолжают из глобального лучшего решения, опубликованного на барьере
+        if (!eliteArchive_ && !islandModel_) {
+            auto global = takeGlobalUpdate(seenGlobalVersion);
+            if (global) {
+                algorithm.setCurrentSolution(global);
+            }
+        }
+        
+        if (runFinished) {
+            // Перезапуск после обмена, чтобы архив уже содержал результаты всех потоков
+            if (eliteArchive_) {
+                algorithm.setCurrentSolution(eliteArchive_->select(restartGenerator));
+            }
+            algorithm.start();
+        }
     }
     
-    Logger::log("Worker thread " + std::to_string(threadId) + " finished");
+    // Callback'и ссылаются на локальные переменные потока
+    algorithm.setImprovementCallback(nullptr);
+    algorithm.setExternalSolutionSource(nullptr);
+    algorithm.setEliteSource(nullptr);
+    
+    barrier_.leave();
+    
+    LOG_INFO("Worker thread " + std::to_string(threadId) + " finished");
 }
 
 void ParallelSimulatedAnnealing::initializeThreads() {
-    threads_.clear();
-    threads_.reserve(numThreads_);
+    // ThreadData содержит атомарные слоты и не перемещается, поэтому вектор создаётся сразу нужного размера
+    std::vector<ThreadData>(numThreads_).swap(threads_);
     
-    Logger::log("Initializing " + std::to_string(numThreads_) + " worker threads");
+    LOG_INFO("Initializing " + std::to_string(numThreads_) + " worker threads");
     
     for (int i = 0; i < numThreads_; ++i) {
-        threads_.emplace_back();
-        threads_[i].bestFitness = std::numeric_limits<double>::max();
+        // Объект алгоритма создаётся до запуска потока, чтобы координатор и сборщик метрик
+        // никогда не видели его частично созданным
+        threads_[i].algorithm = std::make_unique<SimulatedAnnealing>();
         threads_[i].thread = std::thread(&ParallelSimulatedAnnealing::workerThread, this, i);
     }
     
-    Logger::log("All worker threads started");
+    LOG_INFO("All worker threads started");
 }
 
 void ParallelSimulatedAnnealing::stop() {
-    Logger::log("Stopping parallel algorithm and all worker threads");
+    LOG_INFO("Stopping parallel algorithm and all worker threads");
     
-    shouldStop_ = true;
+    requestStop();
     
     for (auto& threadData : threads_) {
-        if (threadData.algorithm) {
-            threadData.algorithm->stop();
+        if (threadData.thread.joinable()) {
+            threadData.thread.join();
         }
     }
     
+    LOG_INFO("All worker threads stopped");
+}
+
+void ParallelSimulatedAnnealing::requestStop() {
+    shouldStop_ = true;
+    barrier_.stop();
+    
+    // Вектор потоков не меняется, пока они работают, а stop() алгоритма только выставляет флаг
     for (auto& threadData : threads_) {
-        if (threadData.thread.joinable()) {
-            threadData.thread.join();
+        if (threadData.algorithm) {
+            threadData.algorithm->stop();
         }
     }
-    
-    Logger::log("All worker threads stopped");
+}
+
+void ParallelSimulatedAnnealing::reportImprovement(int threadId, const std::shared_ptr<ISolution>& solution,
+                                                   double fitness) {
+    // Большинство улучшений потока не улучшают общий рекорд и отсеиваются без блокировки
+    if (fitness >= reportedFitness_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(improvementMutex_);
+    if (fitness >= reportedFitness_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    reportedFitness_.store(fitness, std::memory_order_relaxed);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart_).count();
+    improvementCallback_(Improvement{fitness, seconds, solution, threadId});
 }
 
 bool ParallelSimulatedAnnealing::exchangeSolutions() {
     bool globalImproved = false;
     double previousBest = globalBestFitness_;
+    ++exchangeCount_;
     
     for (auto& threadData : threads_) {
-        std::lock_guard<std::mutex> lock(threadData.solutionMutex);
-        if (threadData.bestSolution && threadData.bestFitness < globalBestFitness_) {
-            globalBestFitness_ = threadData.bestFitness;
-            globalBestSolution_ = threadData.bestSolution->clone();
+        // Предложения архиву идут в порядке потоков, поэтому его содержимое не зависит от планировщика
+        if (threadData.runBestSolution && eliteArchive_) {
+            eliteArchive_->offer(threadData.runBestSolution, threadData.runBestFitness);
+        }
+        threadData.runBestSolution.reset();
+        
+        auto best = threadData.best.load();
+        if (best && best->fitness < globalBestFitness_) {
+            globalBestFitness_ = best->fitness;
+            globalBestSolution_ = best->solution->clone();
             globalImproved = true;
-            std::cout << "Global improvment to : " << threadData.bestFitness << std::endl;
-            
-            Logger::log("GLOBAL IMPROVEMENT: thread " + 
-                        std::to_string(&threadData - &threads_[0]) +
-                        " improved fitness from " + std::to_string(previousBest) +
-                        " to " + std::to_string(globalBestFitness_));
+            LOG_INFO("GLOBAL IMPROVEMENT: thread " + 
+                     std::to_string(&threadData - &threads_[0]) +
+                     " improved fitness from " + std::to_string(previousBest) +
+                     " to " + std::to_string(globalBestFitness_));
         }
     }
     
     if (globalImproved) {
-        Logger::log("Broadcasting global best solution to all threads");
-        for (auto& threadData : threads_) {
-            if (threadData.algorithm && globalBestSolution_) {
-                std::lock_guard<std::mutex> lock(threadData.solutionMutex);
-                threadData.algorithm->setCurrentSolution(globalBestSolution_);
-            }
-        }
+        ++globalImprovementCount_;
+    }
+    
+    if (globalImproved && eliteArchive_) {
+        LOG_DEBUG("Global best kept in elite archive, workers restart from archive members");
+    } else if (globalImproved && islandModel_) {
+        LOG_DEBUG("Global best recorded, islands exchange only through migration");
+    } else if (globalImproved) {
+        LOG_DEBUG("Publishing global best solution to all threads");
     } else {
-        Logger::log("No global improvement in this exchange");
+        LOG_DEBUG("No global improvement in this exchange");
+    }
+    
+    // Снимок - отдельная копия: globalBestSolution_ возвращается вызывающему коду и может изменяться
+    if (globalImproved && globalSnapshot_.publishIfBetter(globalBestSolution_->clone(), globalBestFitness_)) {
+        snapshotPublishCount_.fetch_add(1, std::memory_order_relaxed);
     }
     
     return globalImproved;
 }
 
-std::shared_ptr<ISolution> ParallelSimulatedAnnealing::createThreadSpecificSolution() {
+std::shared_ptr<ISolution> ParallelSimulatedAnnealing::createThreadSpecificSolution(
+    const std::shared_ptr<IMutation>& mutation) {
     if (!initialSolutionTemplate_) {
         return nullptr;
     }
     
-    auto solution = mutation_->apply(initialSolutionTemplate_->clone());
+    auto solution = mutation->apply(initialSolutionTemplate_->clone());
     
     return solution;
+}
+
+std::shared_ptr<ISolution> ParallelSimulatedAnnealing::takeGlobalUpdate(std::uint64_t& seenVersion) {
+    std::uint64_t version = globalSnapshot_.version();
+    if (version == seenVersion) {
+        return nullptr;
+    }
+    seenVersion = version;
+    
+    auto entry = globalSnapshot_.load();
+    if (!entry) {
+        return nullptr;
+    }
+    snapshotImportCount_.fetch_add(1, std::memory_order_relaxed);
+    return entry->solution;
+}
+
+void ParallelSimulatedAnnealing::emigrate(int threadId, std::uint64_t epoch, double& lastEmigrantFitness) {
+    auto best = threads_[threadId].best.load();
+    if (!best) {
+        return;
+    }
+    // Элитная политика отправляет только решения, улучшившие лучшее решение острова с прошлой миграции
+    if (migrationPolicy_ == IslandModel::Policy::EliteOnly && best->fitness >= lastEmigrantFitness) {
+        return;
+    }
+    lastEmigrantFitness = best->fitness;
+    
+    int links = static_cast<int>(islandModel_->neighbours(threadId).size());
+    int sent = islandModel_->emigrate(threadId, Migrant{best->solution, best->fitness, epoch});
+    migrationsSentCount_.fetch_add(sent, std::memory_order_relaxed);
+    migrationsDroppedCount_.fetch_add(links - sent, std::memory_order_relaxed);
+}
+
+void ParallelSimulatedAnnealing::immigrate(int threadId, std::uint64_t epoch, std::vector<Migrant>& immigrants,
+                                           RandomGenerator& generator) {
+    immigrants.clear();
+    islandModel_->receive(threadId, epoch, immigrants);
+    if (immigrants.empty()) {
+        return;
+    }
+    
+    auto& algorithm = *threads_[threadId].algorithm;
+    const Migrant& candidate = *std::min_element(immigrants.begin(), immigrants.end(),
+        [](const Migrant& first, const Migrant& second) { return first.fitness < second.fitness; });
+    
+    // У острова одно текущее решение, оно и считается худшим членом популяции
+    bool accepted = false;
+    switch (migrationPolicy_) {
+    case IslandModel::Policy::BestReplacesWorst:
+        accepted = candidate.fitness < algorithm.getCurrentFitness();
+        break;
+    case IslandModel::Policy::Probabilistic: {
+        double delta = candidate.fitness - algorithm.getCurrentFitness();
+        double temperature = algorithm.getCurrentTemperature();
+        accepted = delta <= 0 || (temperature > 0 && generator.nextDouble() < std::exp(-delta / temperature));
+        break;
+    }
+    case IslandModel::Policy::EliteOnly:
+        accepted = candidate.fitness < algorithm.getBestFitness();
+        break;
+    }
+    
+    if (accepted) {
+        algorithm.setCurrentSolution(candidate.solution);
+        migrationsAcceptedCount_.fetch_add(1, std::memory_order_relaxed);
+    }
+    // Очищается сразу, чтобы вектор не удерживал чужие решения до следующей миграции
+    immigrants.clear();
+}
+
+void ParallelSimulatedAnnealing::samplerThread() {
+    std::ofstream file(metricsSamplePath_, std::ios::out | std::ios::app);
+    if (!file.is_open()) {
+        LOG_INFO("ERROR: Cannot open metrics sample file: " + metricsSamplePath_);
+        return;
+    }
+    
+    std::unique_lock<std::mutex> lock(samplerMutex_);
+    while (samplerRunning_) {
+        samplerCondition_.wait_for(lock, std::chrono::milliseconds(metricsSampleInterval_));
+        file << getMetrics().toJson() << '\n';
+        file.flush();
+    }
 }
\ No newline at end of file
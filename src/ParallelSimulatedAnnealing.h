@@ -1,18 +1,37 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <string>
 #include <vector>
 #include <memory>
 #include <thread>
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
+#include <functional>
 #include "SimulatedAnnealing.h"
 #include "ISolution.h"
 #include "IMutation.h"
 #include "ICoolingLaw.h"
+#include "EliteArchive.h"
+#include "EpochBarrier.h"
+#include "IslandModel.h"
+#include "SolutionSnapshot.h"
+#include "AnnealingMetrics.h"
 
 class ParallelSimulatedAnnealing {
 public:
+    // Новое лучшее решение алгоритма: время от начала run() и снимок, который больше не изменяется
+    struct Improvement {
+        double fitness;
+        double seconds;
+        std::shared_ptr<ISolution> solution;
+        int thread;
+    };
+    using ImprovementCallback = std::function<void(const Improvement&)>;
+    
     explicit ParallelSimulatedAnnealing(int numThreads);
     ~ParallelSimulatedAnnealing();
     
@@ -24,36 +43,43 @@ public:
     void setMaxIterationsWithoutImprovement(int iterations);
     void setMaxIterationsWithoutImprovementGlobal(int iterations);
     void setExchangeInterval(int interval);
+    void setSeed(std::uint64_t seed);
+    void setEliteArchive(int size, int minDistance);
+    void setMetricsSampling(const std::string& path, int intervalMilliseconds);
+    void setEpochIterations(long long iterations);
+    void setAsyncExchange(bool enabled);
+    void setBatchProposals(int batchSize, SimulatedAnnealing::BatchSelection selection);
+    void setRejectionFree(int sampleSize, double acceptanceThreshold);
+    // Элитный перезапуск берёт решение из архива, а без него - глобальное лучшее решение
+    void setStagnationStrategy(SimulatedAnnealing::StagnationStrategy strategy, int maxRestarts,
+                               double reheatFraction, int kickMoves);
+    void setIslandModel(IslandModel::Topology topology, IslandModel::Policy policy, int degree, int migrationInterval);
+    // Режим с ограничением по времени: run() возвращает лучшее решение, как только истёк срок от начала run(),
+    // какой-либо поток достиг целевой пригодности или выставлен флаг прерывания - или раньше, по обычным критериям
+    void setTimeLimit(double seconds);
+    void setTargetFitness(double fitness);
+    void setInterruptFlag(const std::atomic<bool>* flag);
+    // Вызывается из рабочих потоков по очереди, пригодность строго убывает; пока callback
+    // выполняется, потоки с новыми рекордами ждут, поэтому он должен быть коротким
+    void setImprovementCallback(ImprovementCallback callback);
     
     std::shared_ptr<ISolution> run();
     void stop();
+    
+    ParallelMetrics getMetrics() const;
 
 private:
     struct ThreadData {
         std::unique_ptr<SimulatedAnnealing> algorithm;
-        std::shared_ptr<ISolution> bestSolution;
-        double bestFitness;
+        // Лучшее решение потока за все прогоны: поток публикует, координатор читает без блокировок
+        SolutionSnapshot best;
+        // Лучшее решение завершённого прогона, ещё не предложенное архиву;
+        // пишется потоком до барьера и читается координатором на барьере
+        std::shared_ptr<ISolution> runBestSolution;
+        double runBestFitness;
         std::thread thread;
-        std::mutex solutionMutex;
         
-        ThreadData() : bestFitness(std::numeric_limits<double>::max()) {}
-        ThreadData(const ThreadData&) = delete;
-        ThreadData& operator=(const ThreadData&) = delete;
-        ThreadData(ThreadData&& other) noexcept
-            : algorithm(std::move(other.algorithm))
-            , bestSolution(std::move(other.bestSolution))
-            , bestFitness(other.bestFitness)
-            , thread(std::move(other.thread)) {
-        }
-        ThreadData& operator=(ThreadData&& other) noexcept {
-            if (this != &other) {
-                algorithm = std::move(other.algorithm);
-                bestSolution = std::move(other.bestSolution);
-                bestFitness = other.bestFitness;
-                thread = std::move(other.thread);
-            }
-            return *this;
-        }
+        ThreadData() : runBestFitness(std::numeric_limits<double>::max()) {}
     };
     
     int numThreads_;
@@ -64,6 +90,20 @@ private:
     std::shared_ptr<ISolution> globalBestSolution_;
     std::atomic<double> globalBestFitness_;
     
+    // Глобальное лучшее решение для потоков; в асинхронном режиме потоки сами публикуют
+    // в него улучшения и подхватывают его на шагах температуры, не дожидаясь барьера
+    SolutionSnapshot globalSnapshot_;
+    bool asyncExchange_;
+    
+    // Островная модель: вместо рассылки глобального лучшего решения потоки обмениваются
+    // мигрантами с соседями по топологии раз в migrationInterval_ эпох
+    bool islandsEnabled_;
+    IslandModel::Topology islandTopology_;
+    IslandModel::Policy migrationPolicy_;
+    int islandDegree_;
+    int migrationInterval_;
+    std::unique_ptr<IslandModel> islandModel_;
+    
     std::vector<ThreadData> threads_;
     
     std::shared_ptr<ISolution> initialSolutionTemplate_;
@@ -73,9 +113,61 @@ private:
     int iterationsPerTemperature_;
     int maxIterationsWithoutImprovement_;
     int maxIterationsWithoutImprovementGlobal_;
+    std::uint64_t seed_;
+    int eliteArchiveSize_;
+    int eliteMinDistance_;
+    std::unique_ptr<EliteArchive> eliteArchive_;
+    
+    // Эпохи: каждый поток выполняет epochIterations_ итераций и ждёт на барьере,
+    // координатор проводит обмен и открывает следующую эпоху
+    long long epochIterations_;
+    EpochBarrier barrier_;
+    
+    int batchSize_;
+    SimulatedAnnealing::BatchSelection batchSelection_;
+    int rejectionFreeSampleSize_;
+    double rejectionFreeThreshold_;
+    SimulatedAnnealing::StagnationStrategy stagnationStrategy_;
+    int maxRestarts_;
+    double reheatFraction_;
+    int kickMoves_;
+    
+    double timeLimit_;
+    double targetFitness_;
+    const std::atomic<bool>* interruptFlag_;
+    std::chrono::steady_clock::time_point deadline_;
+    ImprovementCallback improvementCallback_;
+    std::mutex improvementMutex_;
+    // Пригодность последнего сообщённого решения; читается без блокировки, чтобы не сообщать лишнего
+    std::atomic<double> reportedFitness_;
+    
+    std::atomic<std::uint64_t> exchangeCount_;
+    std::atomic<std::uint64_t> globalImprovementCount_;
+    std::atomic<std::uint64_t> snapshotPublishCount_;
+    std::atomic<std::uint64_t> snapshotImportCount_;
+    std::atomic<std::uint64_t> migrationsSentCount_;
+    std::atomic<std::uint64_t> migrationsAcceptedCount_;
+    std::atomic<std::uint64_t> migrationsDroppedCount_;
+    std::atomic<bool> isRunning_;
+    std::chrono::steady_clock::time_point runStart_;
+    std::chrono::steady_clock::time_point runEnd_;
+    
+    std::string metricsSamplePath_;
+    int metricsSampleInterval_;
+    std::thread samplerThread_;
+    std::mutex samplerMutex_;
+    std::condition_variable samplerCondition_;
+    bool samplerRunning_;
     
     void workerThread(int threadId);
+    // Остановка без ожидания потоков: безопасна из рабочего потока
+    void requestStop();
+    void reportImprovement(int threadId, const std::shared_ptr<ISolution>& solution, double fitness);
     void initializeThreads();
     bool exchangeSolutions();
-    std::shared_ptr<ISolution> createThreadSpecificSolution();
+    std::shared_ptr<ISolution> takeGlobalUpdate(std::uint64_t& seenVersion);
+    void emigrate(int threadId, std::uint64_t epoch, double& lastEmigrantFitness);
+    void immigrate(int threadId, std::uint64_t epoch, std::vector<Migrant>& immigrants, RandomGenerator& generator);
+    void samplerThread();
+    std::shared_ptr<ISolution> createThreadSpecificSolution(const std::shared_ptr<IMutation>& mutation);
 };
\ No newline at end of file
@@ -0,0 +1,335 @@
+#include "ParallelTempering.h"
+#include "ConstantCooling.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+ParallelTempering::ParallelTempering(int numReplicas)
+    : numReplicas_(numReplicas)
+    , minTemperature_(1.0)
+    , maxTemperature_(1000.0)
+    , iterationsPerTemperature_(1000)
+    , maxIterationsWithoutImprovement_(100)
+    , maxSyncsWithoutImprovement_(10)
+    , syncIterations_(10000)
+    , targetSwapRate_(0.23)
+    , adaptiveLadder_(true)
+    , seed_(RandomGenerator::clockSeed())
+    , globalBestFitness_(std::numeric_limits<double>::max())
+    , shouldStop_(false)
+    , syncCount_(0)
+    , globalImprovementCount_(0)
+    , swapAttempts_(0)
+    , swapAccepts_(0)
+    , isRunning_(false) {
+
+    if (numReplicas_ <= 0) {
+        numReplicas_ = std::thread::hardware_concurrency();
+        if (numReplicas_ == 0) numReplicas_ = 1;
+    }
+
+    LOG_INFO("ParallelTempering created with " + std::to_string(numReplicas_) + " replicas");
+}
+
+ParallelTempering::~ParallelTempering() {
+    stop();
+}
+
+void ParallelTempering::setInitialSolution(const std::shared_ptr<ISolution>& solution) {
+    initialSolutionTemplate_ = solution;
+}
+
+void ParallelTempering::setMutation(const std::shared_ptr<IMutation>& mutation) {
+    mutation_ = mutation;
+}
+
+void ParallelTempering::setTemperatureRange(double minTemperature, double maxTemperature) {
+    if (minTemperature <= 0 || maxTemperature < minTemperature) {
+        throw std::invalid_argument("Invalid tempering temperature range");
+    }
+    minTemperature_ = minTemperature;
+    maxTemperature_ = maxTemperature;
+    LOG_INFO("Tempering temperature range set to: " + std::to_string(minTemperature) +
+             " .. " + std::to_string(maxTemperature));
+}
+
+void ParallelTempering::setIterationsPerTemperature(int iterations) {
+    iterationsPerTemperature_ = iterations;
+}
+
+void ParallelTempering::setMaxIterationsWithoutImprovement(int iterations) {
+    maxIterationsWithoutImprovement_ = iterations;
+}
+
+void ParallelTempering::setMaxSyncsWithoutImprovement(int syncs) {
+    maxSyncsWithoutImprovement_ = syncs;
+    LOG_INFO("Tempering max syncs without improvement set to: " + std::to_string(syncs));
+}
+
+void ParallelTempering::setSyncIterations(long long iterations) {
+    if (iterations <= 0) {
+        throw std::invalid_argument("Sync iterations must be positive");
+    }
+    syncIterations_ = iterations;
+    LOG_INFO("Tempering sync iterations set to: " + std::to_string(iterations));
+}
+
+void ParallelTempering::setTargetSwapRate(double rate) {
+    if (rate <= 0.0 || rate >= 1.0) {
+        throw std::invalid_argument("Target swap rate must be in (0, 1)");
+    }
+    targetSwapRate_ = rate;
+    LOG_INFO("Tempering target swap rate set to: " + std::to_string(rate));
+}
+
+void ParallelTempering::setAdaptiveLadder(bool enabled) {
+    adaptiveLadder_ = enabled;
+}
+
+void ParallelTempering::setSeed(std::uint64_t seed) {
+    seed_ = seed;
+    LOG_INFO("Tempering random seed set to: " + std::to_string(seed));
+}
+
+std::vector<double> ParallelTempering::getTemperatures() const {
+    std::lock_guard<std::mutex> lock(temperaturesMutex_);
+    return temperatures_;
+}
+
+ParallelMetrics ParallelTempering::getMetrics() const {
+    ParallelMetrics metrics;
+    for (const auto& replica : replicas_) {
+        AnnealingMetrics replicaMetrics = replica.algorithm ? replica.algorithm->getMetrics() : AnnealingMetrics();
+        metrics.total.add(replicaMetrics);
+        metrics.threads.push_back(replicaMetrics);
+    }
+    metrics.exchanges = syncCount_.load(std::memory_order_relaxed);
+    metrics.globalImprovements = globalImprovementCount_.load(std::memory_order_relaxed);
+    metrics.swapAttempts = swapAttempts_.load(std::memory_order_relaxed);
+    metrics.swapAccepts = swapAccepts_.load(std::memory_order_relaxed);
+    metrics.temperatures = getTemperatures();
+
+    auto end = isRunning_ ? std::chrono::steady_clock::now() : runEnd_;
+    metrics.wallSeconds = std::chrono::duration<double>(end - runStart_).count();
+    return metrics;
+}
+
+std::shared_ptr<ISolution> ParallelTempering::run() {
+    if (!initialSolutionTemplate_ || !mutation_) {
+        LOG_INFO("ERROR: Parallel tempering not properly initialized");
+        return nullptr;
+    }
+
+    globalBestSolution_ = initialSolutionTemplate_->clone();
+    globalBestFitness_ = globalBestSolution_->fitness();
+    double initialFitness = globalBestFitness_;
+
+    initializeLadder();
+    swapGenerator_.seed(RandomGenerator::deriveSeed(seed_, 3 * static_cast<std::uint64_t>(numReplicas_)));
+
+    shouldStop_ = false;
+    syncCount_ = 0;
+    globalImprovementCount_ = 0;
+    swapAttempts_ = 0;
+    swapAccepts_ = 0;
+    runStart_ = std::chrono::steady_clock::now();
+    isRunning_ = true;
+
+    LOG_INFO("Parallel tempering STARTED: replicas=" + std::to_string(numReplicas_) +
+             ", initial_fitness=" + std::to_string(initialFitness) +
+             ", sync_iterations=" + std::to_string(syncIterations_));
+
+    barrier_.reset(numReplicas_);
+    std::vector<Replica>(numReplicas_).swap(replicas_);
+    for (int i = 0; i < numReplicas_; ++i) {
+        replicas_[i].algorithm = std::make_unique<SimulatedAnnealing>();
+        replicas_[i].thread = std::thread(&ParallelTempering::replicaThread, this, i);
+    }
+
+    int syncsWithoutImprovement = 0;
+    int round = 0;
+
+    while (!shouldStop_) {
+        if (!barrier_.waitForAll()) {
+            break;
+        }
+        ++syncCount_;
+
+        // Все реплики стоят на барьере: состояния и температуры меняются без гонок
+        if (collectBest()) {
+            syncsWithoutImprovement = 0;
+        } else {
+            ++syncsWithoutImprovement;
+        }
+        if (syncsWithoutImprovement >= maxSyncsWithoutImprovement_) {
+            break;
+        }
+
+        // Чётные и нечётные пары соседей чередуются, чтобы каждая реплика участвовала в одном обмене
+        swapNeighbours(round % 2);
+        ++round;
+
+        barrier_.release();
+    }
+
+    stop();
+    collectBest();
+
+    runEnd_ = std::chrono::steady_clock::now();
+    isRunning_ = false;
+
+    LOG_INFO("Parallel tempering FINISHED: syncs=" + std::to_string(syncCount_.load()) +
+             ", swaps=" + std::to_string(swapAccepts_.load()) + "/" + std::to_string(swapAttempts_.load()) +
+             ", final_fitness=" + std::to_string(globalBestFitness_) +
+             ", total_improvement=" + std::to_string(initialFitness - globalBestFitness_));
+
+    return globalBestSolution_;
+}
+
+void ParallelTempering::stop() {
+    shouldStop_ = true;
+    barrier_.stop();
+
+    for (auto& replica : replicas_) {
+        if (replica.algorithm) {
+            replica.algorithm->stop();
+        }
+    }
+
+    for (auto& replica : replicas_) {
+        if (replica.thread.joinable()) {
+            replica.thread.join();
+        }
+    }
+}
+
+void ParallelTempering::replicaThread(int replicaIndex) {
+    auto& replica = replicas_[replicaIndex];
+    auto& algorithm = *replica.algorithm;
+
+    std::uint64_t stream = 3 * static_cast<std::uint64_t>(replicaIndex);
+    auto mutation = mutation_->clone();
+    mutation->setSeed(RandomGenerator::deriveSeed(seed_, stream));
+
+    algorithm.setSeed(RandomGenerator::deriveSeed(seed_, stream + 1));
+    algorithm.setInitialSolution(mutation->apply(initialSolutionTemplate_->clone()));
+    algorithm.setMutation(mutation);
+    algorithm.setCoolingLaw(std::make_shared<ConstantCooling>());
+    algorithm.setInitialTemperature(getTemperatures()[replicaIndex]);
+    algorithm.setIterationsPerTemperature(iterationsPerTemperature_);
+    algorithm.setMaxIterationsWithoutImprovement(maxIterationsWithoutImprovement_);
+    algorithm.setImprovementCallback([&replica](const std::shared_ptr<ISolution>& solution, double fitness) {
+        replica.best.publishIfBetter(solution, fitness);
+    });
+    algorithm.start();
+
+    std::uint64_t epoch = 0;
+
+    while (!shouldStop_) {
+        // Реплика не останавливается при стагнации: счётчик сбрасывается, температура прежняя
+        if (algorithm.advance(syncIterations_)) {
+            algorithm.start();
+        }
+
+        if (!barrier_.arriveAndWait(epoch)) {
+            break;
+        }
+    }
+
+    algorithm.setImprovementCallback(nullptr);
+    barrier_.leave();
+}
+
+void ParallelTempering::initializeLadder() {
+    std::lock_guard<std::mutex> lock(temperaturesMutex_);
+    temperatures_.assign(numReplicas_, minTemperature_);
+    gapWeights_.assign(std::max(numReplicas_ - 1, 0), 1.0);
+    swapRates_.assign(gapWeights_.size(), targetSwapRate_);
+
+    // Начальная лестница - геометрическая прогрессия от minTemperature_ до maxTemperature_
+    for (int i = 1; i < numReplicas_; ++i) {
+        double ratio = static_cast<double>(i) / (numReplicas_ - 1);
+        temperatures_[i] = minTemperature_ * std::pow(maxTemperature_ / minTemperature_, ratio);
+    }
+}
+
+bool ParallelTempering::collectBest() {
+    bool improved = false;
+    for (auto& replica : replicas_) {
+        auto best = replica.best.load();
+        if (best && best->fitness < globalBestFitness_) {
+            globalBestFitness_ = best->fitness;
+            globalBestSolution_ = best->solution->clone();
+            improved = true;
+        }
+    }
+
+    if (improved) {
+        ++globalImprovementCount_;
+        LOG_INFO("GLOBAL IMPROVEMENT: fitness " + std::to_string(globalBestFitness_));
+    }
+    return improved;
+}
+
+void ParallelTempering::swapNeighbours(int parity) {
+    std::vector<double> temperatures = getTemperatures();
+
+    for (int i = parity; i + 1 < numReplicas_; i += 2) {
+        auto& colder = *replicas_[i].algorithm;
+        auto& hotter = *replicas_[i + 1].algorithm;
+        auto colderSolution = colder.getCurrentSolution();
+        auto hotterSolution = hotter.getCurrentSolution();
+
+        // Критерий Метрополиса для обмена: min(1, exp((1/T_i - 1/T_j) * (E_i - E_j)))
+        double exponent = (1.0 / temperatures[i] - 1.0 / temperatures[i + 1]) *
+                          (colderSolution->fitness() - hotterSolution->fitness());
+        bool accepted = exponent >= 0.0 || swapGenerator_.nextDouble() < std::exp(exponent);
+
+        ++swapAttempts_;
+        if (accepted) {
+            ++swapAccepts_;
+            colder.setCurrentSolution(hotterSolution);
+            hotter.setCurrentSolution(colderSolution);
+        }
+
+        if (adaptiveLadder_) {
+            adaptLadder(i, accepted);
+        }
+    }
+
+    if (adaptiveLadder_) {
+        rebuildLadder();
+    }
+}
+
+void ParallelTempering::adaptLadder(int pairIndex, bool accepted) {
+    // Скользящая оценка доли обменов пары; промежуток между температурами растёт,
+    // если обмены принимаются чаще цели, и сужается, если реже. Шаг затухает со временем
+    swapRates_[pairIndex] = 0.9 * swapRates_[pairIndex] + 0.1 * (accepted ? 1.0 : 0.0);
+    double gain = 1.0 / std::sqrt(1.0 + static_cast<double>(syncCount_.load()));
+    gapWeights_[pairIndex] *= std::exp(gain * (swapRates_[pairIndex] - targetSwapRate_));
+}
+
+void ParallelTempering::rebuildLadder() {
+    // Концы лестницы фиксированы, веса промежутков задают разбиение отрезка в log T
+    double totalWeight = 0.0;
+    for (double weight : gapWeights_) {
+        totalWeight += weight;
+    }
+    if (totalWeight <= 0.0) {
+        return;
+    }
+
+    double logMin = std::log(minTemperature_);
+    double logRange = std::log(maxTemperature_) - logMin;
+    double cumulative = 0.0;
+
+    std::lock_guard<std::mutex> lock(temperaturesMutex_);
+    for (int i = 1; i < numReplicas_; ++i) {
+        cumulative += gapWeights_[i - 1];
+        temperatures_[i] = std::exp(logMin + logRange * cumulative / totalWeight);
+        replicas_[i].algorithm->setInitialTemperature(temperatures_[i]);
+    }
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "SimulatedAnnealing.h"
+#include "ISolution.h"
+#include "IMutation.h"
+#include "EpochBarrier.h"
+#include "SolutionSnapshot.h"
+#include "RandomGenerator.h"
+#include "AnnealingMetrics.h"
+
+// Параллельный отжиг с обменом реплик (parallel tempering): каждый поток ведёт реплику
+// при постоянной температуре из лестницы, на точках синхронизации соседние реплики
+// обмениваются состояниями по критерию Метрополиса. Лестница подстраивается так,
+// чтобы доля принятых обменов между соседями приближалась к целевой
+class ParallelTempering {
+public:
+    explicit ParallelTempering(int numReplicas);
+    ~ParallelTempering();
+
+    void setInitialSolution(const std::shared_ptr<ISolution>& solution);
+    void setMutation(const std::shared_ptr<IMutation>& mutation);
+    void setTemperatureRange(double minTemperature, double maxTemperature);
+    void setIterationsPerTemperature(int iterations);
+    void setMaxIterationsWithoutImprovement(int iterations);
+    void setMaxSyncsWithoutImprovement(int syncs);
+    void setSyncIterations(long long iterations);
+    void setTargetSwapRate(double rate);
+    void setAdaptiveLadder(bool enabled);
+    void setSeed(std::uint64_t seed);
+
+    std::shared_ptr<ISolution> run();
+    void stop();
+
+    std::vector<double> getTemperatures() const;
+    ParallelMetrics getMetrics() const;
+
+private:
+    struct Replica {
+        std::unique_ptr<SimulatedAnnealing> algorithm;
+        SolutionSnapshot best;
+        std::thread thread;
+    };
+
+    int numReplicas_;
+    double minTemperature_;
+    double maxTemperature_;
+    int iterationsPerTemperature_;
+    int maxIterationsWithoutImprovement_;
+    int maxSyncsWithoutImprovement_;
+    long long syncIterations_;
+    double targetSwapRate_;
+    bool adaptiveLadder_;
+    std::uint64_t seed_;
+
+    std::shared_ptr<ISolution> initialSolutionTemplate_;
+    std::shared_ptr<IMutation> mutation_;
+
+    std::shared_ptr<ISolution> globalBestSolution_;
+    double globalBestFitness_;
+
+    std::vector<Replica> replicas_;
+    // temperatures_[i] возрастает с i; меняется только координатором на барьере
+    std::vector<double> temperatures_;
+    mutable std::mutex temperaturesMutex_;
+    // Веса промежутков лестницы в log T и скользящие доли принятых обменов соседних пар
+    std::vector<double> gapWeights_;
+    std::vector<double> swapRates_;
+    RandomGenerator swapGenerator_;
+    EpochBarrier barrier_;
+    std::atomic<bool> shouldStop_;
+
+    std::atomic<std::uint64_t> syncCount_;
+    std::atomic<std::uint64_t> globalImprovementCount_;
+    std::atomic<std::uint64_t> swapAttempts_;
+    std::atomic<std::uint64_t> swapAccepts_;
+    std::atomic<bool> isRunning_;
+    std::chrono::steady_clock::time_point runStart_;
+    std::chrono::steady_clock::time_point runEnd_;
+
+    void replicaThread(int replicaIndex);
+    void initializeLadder();
+    bool collectBest();
+    void swapNeighbours(int parity);
+    void adaptLadder(int pairIndex, bool accepted);
+    void rebuildLadder();
+};
@@ -0,0 +1,78 @@
+#include "ProcessorIndexArray.h"
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+ProcessorIndexArray::ProcessorIndexArray()
+    : size_(0)
+    , width_(1) {
+}
+
+ProcessorIndexArray::ProcessorIndexArray(int size, int processorCount)
+    : size_(size)
+    , width_(4) {
+    if (size_ < 0 || processorCount < 0) {
+        throw std::invalid_argument("Size and processor count must be non-negative");
+    }
+
+    // Максимальное значение типа зарезервировано под "не назначена"
+    if (processorCount < std::numeric_limits<std::uint8_t>::max()) {
+        width_ = 1;
+    } else if (processorCount < std::numeric_limits<std::uint16_t>::max()) {
+        width_ = 2;
+    }
+
+    data_.assign(static_cast<size_t>(size_) * width_, 0xFF);
+}
+
+int ProcessorIndexArray::get(int index) const {
+    const std::uint8_t* element = data_.data() + static_cast<size_t>(index) * width_;
+    switch (width_) {
+        case 1: {
+            std::uint8_t value = *element;
+            return value == std::numeric_limits<std::uint8_t>::max() ? -1 : value;
+        }
+        case 2: {
+            std::uint16_t value;
+            std::memcpy(&value, element, sizeof(value));
+            return value == std::numeric_limits<std::uint16_t>::max() ? -1 : value;
+        }
+        default: {
+            std::uint32_t value;
+            std::memcpy(&value, element, sizeof(value));
+            return value == std::numeric_limits<std::uint32_t>::max() ? -1 : static_cast<int>(value);
+        }
+    }
+}
+
+void ProcessorIndexArray::set(int index, int processorIndex) {
+    std::uint8_t* element = data_.data() + static_cast<size_t>(index) * width_;
+    switch (width_) {
+        case 1: {
+            std::uint8_t value = processorIndex < 0 ? std::numeric_limits<std::uint8_t>::max()
+                                                    : static_cast<std::uint8_t>(processorIndex);
+            *element = value;
+            break;
+        }
+        case 2: {
+            std::uint16_t value = processorIndex < 0 ? std::numeric_limits<std::uint16_t>::max()
+                                                     : static_cast<std::uint16_t>(processorIndex);
+            std::memcpy(element, &value, sizeof(value));
+            break;
+        }
+        default: {
+            std::uint32_t value = processorIndex < 0 ? std::numeric_limits<std::uint32_t>::max()
+                                                     : static_cast<std::uint32_t>(processorIndex);
+            std::memcpy(element, &value, sizeof(value));
+            break;
+        }
+    }
+}
+
+int ProcessorIndexArray::size() const {
+    return size_;
+}
+
+int ProcessorIndexArray::width() const {
+    return width_;
+}
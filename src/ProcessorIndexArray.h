@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Компактный массив "работа -> процессор": ширина элемента (1, 2 или 4 байта)
+// выбирается по числу процессоров, всё хранится в одном непрерывном буфере
+class ProcessorIndexArray {
+public:
+    ProcessorIndexArray();
+    ProcessorIndexArray(int size, int processorCount);
+
+    int get(int index) const;
+    void set(int index, int processorIndex);
+
+    int size() const;
+    int width() const;
+
+private:
+    int size_;
+    int width_;
+    std::vector<std::uint8_t> data_;
+};
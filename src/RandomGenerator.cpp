@@ -0,0 +1,38 @@
+#include "RandomGenerator.h"
+#include <chrono>
+
+namespace {
+
+std::uint64_t splitMix64(std::uint64_t& state) {
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+}
+
+RandomGenerator::RandomGenerator()
+    : RandomGenerator(clockSeed()) {
+}
+
+RandomGenerator::RandomGenerator(std::uint64_t seed) {
+    this->seed(seed);
+}
+
+void RandomGenerator::seed(std::uint64_t seed) {
+    // Состояние из SplitMix64 никогда не бывает полностью нулевым
+    std::uint64_t state = seed;
+    for (auto& word : state_) {
+        word = splitMix64(state);
+    }
+}
+
+std::uint64_t RandomGenerator::deriveSeed(std::uint64_t masterSeed, std::uint64_t streamIndex) {
+    std::uint64_t state = masterSeed ^ splitMix64(streamIndex);
+    return splitMix64(state);
+}
+
+std::uint64_t RandomGenerator::clockSeed() {
+    return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+// Быстрый генератор xoshiro256** (совместим с UniformRandomBitGenerator).
+// Каждому потоку - своя копия, зерна выводятся из одного главного зерна через deriveSeed
+class RandomGenerator {
+public:
+    using result_type = std::uint64_t;
+
+    RandomGenerator();
+    explicit RandomGenerator(std::uint64_t seed);
+
+    void seed(std::uint64_t seed);
+
+    // Горячий путь: определения в заголовке, чтобы вызов встраивался
+    result_type operator()() {
+        const std::uint64_t result = rotl(state_[1] * 5, 7) * 9;
+        const std::uint64_t t = state_[1] << 17;
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = rotl(state_[3], 45);
+        return result;
+    }
+
+    // Равномерно распределённое число в [0, 1) из старших 53 бит
+    double nextDouble() {
+        return static_cast<double>((*this)() >> 11) * 0x1.0p-53;
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    static std::uint64_t deriveSeed(std::uint64_t masterSeed, std::uint64_t streamIndex);
+    static std::uint64_t clockSeed();
+
+private:
+    std::uint64_t state_[4];
+
+    static std::uint64_t rotl(std::uint64_t value, int shift) {
+        return (value << shift) | (value >> (64 - shift));
+    }
+};
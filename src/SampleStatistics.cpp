@@ -0,0 +1,67 @@
+#include "SampleStatistics.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace {
+
+// Двусторонние 95% квантили t-распределения для 1..30 степеней свободы;
+// дальше распределение неотличимо от нормального на практике
+constexpr double kStudentQuantiles[] = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+};
+constexpr double kNormalQuantile = 1.960;
+
+double studentQuantile(size_t degreesOfFreedom) {
+    constexpr size_t tableSize = sizeof(kStudentQuantiles) / sizeof(kStudentQuantiles[0]);
+    return degreesOfFreedom <= tableSize ? kStudentQuantiles[degreesOfFreedom - 1] : kNormalQuantile;
+}
+
+}
+
+SampleStatistics SampleStatistics::compute(std::vector<double> values) {
+    SampleStatistics statistics;
+    statistics.count = values.size();
+    if (values.empty()) {
+        return statistics;
+    }
+
+    double sum = 0.0;
+    for (double value : values) {
+        sum += value;
+    }
+    statistics.mean = sum / values.size();
+
+    std::sort(values.begin(), values.end());
+    size_t middle = values.size() / 2;
+    statistics.median = values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+
+    statistics.confidenceLow = statistics.mean;
+    statistics.confidenceHigh = statistics.mean;
+    if (values.size() > 1) {
+        double squares = 0.0;
+        for (double value : values) {
+            squares += (value - statistics.mean) * (value - statistics.mean);
+        }
+        statistics.standardDeviation = std::sqrt(squares / (values.size() - 1));
+
+        double halfWidth = studentQuantile(values.size() - 1) * statistics.standardDeviation / std::sqrt(values.size());
+        statistics.confidenceLow -= halfWidth;
+        statistics.confidenceHigh += halfWidth;
+    }
+    return statistics;
+}
+
+std::string SampleStatistics::toJson() const {
+    std::ostringstream json;
+    json << "{\"count\":" << count
+         << ",\"mean\":" << mean
+         << ",\"median\":" << median
+         << ",\"stddev\":" << standardDeviation
+         << ",\"ci95_low\":" << confidenceLow
+         << ",\"ci95_high\":" << confidenceHigh
+         << "}";
+    return json.str();
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Описательная статистика выборки повторных прогонов: среднее, медиана, выборочное
+// стандартное отклонение и 95% доверительный интервал среднего по t-распределению Стьюдента
+struct SampleStatistics {
+    size_t count = 0;
+    double mean = 0.0;
+    double median = 0.0;
+    double standardDeviation = 0.0;
+    double confidenceLow = 0.0;
+    double confidenceHigh = 0.0;
+
+    static SampleStatistics compute(std::vector<double> values);
+    std::string toJson() const;
+};
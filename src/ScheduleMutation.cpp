@@ -1,13 +1,11 @@
 #include "ScheduleMutation.h"
 #include <stdexcept>
-#include <chrono>
 #include <algorithm>
 
 ScheduleMutation::ScheduleMutation()
     : moveProbability_(0.7)
-    , swapProbability_(0.3) {
-    auto seed = std::chrono::steady_clock::now().time_since_epoch().count();
-    randomGenerator_.seed(static_cast<unsigned int>(seed));
+    , swapProbability_(0.3)
+    , randomGenerator_(RandomGenerator::clockSeed()) {
 }
 
 std::shared_ptr<ISolution> ScheduleMutation::apply(const std::shared_ptr<ISolution>& solution) {
@@ -16,21 +14,70 @@ std::shared_ptr<ISolution> ScheduleMutation::apply(const std::shared_ptr<ISoluti
         throw std::invalid_argument("ScheduleMutation can only work with ScheduleSolution");
     }
     
-    double totalProbability = moveProbability_ + swapProbability_;
-    if (std::abs(totalProbability - 1.0) > 1e-6) {
-        throw std::runtime_error("Mutation probabilities must sum to 1.0");
-    }
-    
-    std::uniform_real_distribution<double> distribution(0.0, 1.0);
-    double randomValue = distribution(randomGenerator_);
-    
-    if (randomValue < moveProbability_) {
+    if (chooseMoveOperation()) {
         return applyMoveOperation(scheduleSolution);
     } else {
         return applySwapOperation(scheduleSolution);
     }
 }
 
+std::shared_ptr<IMutation> ScheduleMutation::clone() const {
+    return std::make_shared<ScheduleMutation>(*this);
+}
+
+void ScheduleMutation::setSeed(std::uint64_t seed) {
+    randomGenerator_.seed(seed);
+}
+
+bool ScheduleMutation::supportsMoves() const {
+    return true;
+}
+
+SolutionMove ScheduleMutation::propose(const ISolution& solution) {
+    auto scheduleSolution = dynamic_cast<const ScheduleSolution*>(&solution);
+    if (!scheduleSolution) {
+        throw std::invalid_argument("ScheduleMutation can only work with ScheduleSolution");
+    }
+    
+    if (chooseMoveOperation()) {
+        return proposeMoveOperation(*scheduleSolution);
+    }
+    
+    auto [job1, job2] = selectTwoJobsOnDifferentProcessors(*scheduleSolution);
+    
+    if (job1 == -1 || job2 == -1) {
+        return proposeMoveOperation(*scheduleSolution);
+    }
+    
+    return {SolutionMove::Type::Swap, job1, job2};
+}
+
+void ScheduleMutation::proposeBatch(const ISolution& solution, SolutionMove* moves, int count) {
+    auto scheduleSolution = dynamic_cast<const ScheduleSolution*>(&solution);
+    if (!scheduleSolution) {
+        throw std::invalid_argument("ScheduleMutation can only work with ScheduleSolution");
+    }
+    
+    // Решение в пределах пачки не меняется: приведение типа и список непустых процессоров
+    // получаются один раз, а не на каждое предложение. Случайные числа тратятся так же, как у propose()
+    bool canSwap = scheduleSolution->getJobCount() >= 2 && scheduleSolution->getProcessorCount() >= 2;
+    if (canSwap) {
+        collectNonEmptyProcessors(*scheduleSolution);
+    }
+    
+    for (int i = 0; i < count; ++i) {
+        if (chooseMoveOperation()) {
+            moves[i] = proposeMoveOperation(*scheduleSolution);
+            continue;
+        }
+        
+        auto [job1, job2] = canSwap ? selectTwoJobsAmong(*scheduleSolution, nonEmptyProcessors_)
+                                    : std::pair<int, int>(-1, -1);
+        moves[i] = job1 == -1 || job2 == -1 ? proposeMoveOperation(*scheduleSolution)
+                                            : SolutionMove{SolutionMove::Type::Swap, job1, job2};
+    }
+}
+
 void ScheduleMutation::setMoveProbability(double probability) {
     if (probability < 0.0 || probability > 1.0) {
         throw std::invalid_argument("Probability must be between 0.0 and 1.0");
@@ -52,13 +99,7 @@ std::shared_ptr<ScheduleSolution> ScheduleMutation::applyMoveOperation(
     
     auto newSolution = std::make_shared<ScheduleSolution>(*solution);
     
-    int jobIndex = selectRandomJob(newSolution);
-    
-    int currentProcessor = newSolution->getJobProcessor(jobIndex);
-    
-    int newProcessor = selectRandomProcessorExcept(newSolution, currentProcessor);
-    
-    newSolution->assignJobToProcessor(jobIndex, newProcessor);
+    newSolution->applyMove(proposeMoveOperation(*newSolution));
     
     return newSolution;
 }
@@ -68,87 +109,100 @@ std::shared_ptr<ScheduleSolution> ScheduleMutation::applySwapOperation(
     
     auto newSolution = std::make_shared<ScheduleSolution>(*solution);
     
-    auto [job1, job2] = selectTwoJobsOnDifferentProcessors(newSolution);
+    auto [job1, job2] = selectTwoJobsOnDifferentProcessors(*newSolution);
     
     if (job1 == -1 || job2 == -1) {
         return applyMoveOperation(newSolution);
     }
     
-    int processor1 = newSolution->getJobProcessor(job1);
-    int processor2 = newSolution->getJobProcessor(job2);
-    
-    newSolution->assignJobToProcessor(job1, processor2);
-    newSolution->assignJobToProcessor(job2, processor1);
+    newSolution->swapJobs(job1, job2);
     
     return newSolution;
 }
 
-int ScheduleMutation::selectRandomJob(const std::shared_ptr<ScheduleSolution>& solution) const {
-    std::uniform_int_distribution<int> distribution(0, solution->getJobCount() - 1);
+bool ScheduleMutation::chooseMoveOperation() const {
+    double totalProbability = moveProbability_ + swapProbability_;
+    if (std::abs(totalProbability - 1.0) > 1e-6) {
+        throw std::runtime_error("Mutation probabilities must sum to 1.0");
+    }
+    
+    return randomGenerator_.nextDouble() < moveProbability_;
+}
+
+SolutionMove ScheduleMutation::proposeMoveOperation(const ScheduleSolution& solution) const {
+    int jobIndex = selectRandomJob(solution);
+    
+    int currentProcessor = solution.getJobProcessor(jobIndex);
+    
+    int newProcessor = selectRandomProcessorExcept(solution, currentProcessor);
+    
+    return {SolutionMove::Type::Relocate, jobIndex, newProcessor};
+}
+
+int ScheduleMutation::selectRandomJob(const ScheduleSolution& solution) const {
+    std::uniform_int_distribution<int> distribution(0, solution.getJobCount() - 1);
     return distribution(randomGenerator_);
 }
 
 int ScheduleMutation::selectRandomProcessorExcept(
-    const std::shared_ptr<ScheduleSolution>& solution, int excludedProcessor) const {
+    const ScheduleSolution& solution, int excludedProcessor) const {
     
-    int processorCount = solution->getProcessorCount();
+    int processorCount = solution.getProcessorCount();
     if (processorCount <= 1) {
         throw std::runtime_error("Cannot select different processor when processor count <= 1");
     }
     
-    std::vector<int> availableProcessors;
-    for (int i = 0; i < processorCount; ++i) {
-        if (i != excludedProcessor) {
-            availableProcessors.push_back(i);
-        }
-    }
-    
-    std::uniform_int_distribution<int> distribution(0, availableProcessors.size() - 1);
-    return availableProcessors[distribution(randomGenerator_)];
+    // Равномерный выбор среди processorCount - 1 процессоров без построения списка
+    std::uniform_int_distribution<int> distribution(0, processorCount - 2);
+    int processor = distribution(randomGenerator_);
+    return processor >= excludedProcessor ? processor + 1 : processor;
 }
 
 std::pair<int, int> ScheduleMutation::selectTwoJobsOnDifferentProcessors(
-    const std::shared_ptr<ScheduleSolution>& solution) const {
+    const ScheduleSolution& solution) const {
     
-    int jobCount = solution->getJobCount();
-    int processorCount = solution->getProcessorCount();
-    
-    if (jobCount < 2 || processorCount < 2) {
+    if (solution.getJobCount() < 2 || solution.getProcessorCount() < 2) {
         return {-1, -1};
     }
     
-    std::vector<std::vector<int>> jobsByProcessor(processorCount);
-    for (int i = 0; i < jobCount; ++i) {
-        int processor = solution->getJobProcessor(i);
-        jobsByProcessor[processor].push_back(i);
-    }
-    
-    std::vector<int> nonEmptyProcessors;
-    for (int i = 0; i < processorCount; ++i) {
-        if (!jobsByProcessor[i].empty()) {
-            nonEmptyProcessors.push_back(i);
+    collectNonEmptyProcessors(solution);
+    return selectTwoJobsAmong(solution, nonEmptyProcessors_);
+}
+
+void ScheduleMutation::collectNonEmptyProcessors(const ScheduleSolution& solution) const {
+    nonEmptyProcessors_.clear();
+    for (int i = 0; i < solution.getProcessorCount(); ++i) {
+        if (solution.getProcessorJobCount(i) > 0) {
+            nonEmptyProcessors_.push_back(i);
         }
     }
+}
+
+std::pair<int, int> ScheduleMutation::selectTwoJobsAmong(
+    const ScheduleSolution& solution, const std::vector<int>& processors) const {
     
-    if (nonEmptyProcessors.size() < 2) {
+    int nonEmptyCount = static_cast<int>(processors.size());
+    if (solution.getJobCount() < 2 || nonEmptyCount < 2) {
         return {-1, -1};
     }
     
-    std::uniform_int_distribution<int> processorDist(0, nonEmptyProcessors.size() - 1);
-    int processor1Index = processorDist(randomGenerator_);
-    int processor2Index;
-    do {
-        processor2Index = processorDist(randomGenerator_);
-    } while (processor2Index == processor1Index);
+    // Два различных порядковых номера среди непустых процессоров
+    std::uniform_int_distribution<int> processorDist1(0, nonEmptyCount - 1);
+    std::uniform_int_distribution<int> processorDist2(0, nonEmptyCount - 2);
+    int processor1Index = processorDist1(randomGenerator_);
+    int processor2Index = processorDist2(randomGenerator_);
+    if (processor2Index >= processor1Index) {
+        ++processor2Index;
+    }
     
-    int processor1 = nonEmptyProcessors[processor1Index];
-    int processor2 = nonEmptyProcessors[processor2Index];
+    int processor1 = processors[processor1Index];
+    int processor2 = processors[processor2Index];
     
-    std::uniform_int_distribution<int> jobDist1(0, jobsByProcessor[processor1].size() - 1);
-    std::uniform_int_distribution<int> jobDist2(0, jobsByProcessor[processor2].size() - 1);
+    std::uniform_int_distribution<int> jobDist1(0, solution.getProcessorJobCount(processor1) - 1);
+    std::uniform_int_distribution<int> jobDist2(0, solution.getProcessorJobCount(processor2) - 1);
     
-    int job1 = jobsByProcessor[processor1][jobDist1(randomGenerator_)];
-    int job2 = jobsByProcessor[processor2][jobDist2(randomGenerator_)];
+    int job1 = solution.getProcessorJob(processor1, jobDist1(randomGenerator_));
+    int job2 = solution.getProcessorJob(processor2, jobDist2(randomGenerator_));
     
     return {job1, job2};
-}
\ No newline at end of file
+}
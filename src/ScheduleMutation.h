@@ -2,6 +2,8 @@
 
 #include <memory>
 #include <random>
+#include <vector>
+#include "RandomGenerator.h"
 #include "IMutation.h"
 #include "ScheduleSolution.h"
 
@@ -10,6 +12,12 @@ public:
     ScheduleMutation();
     
     std::shared_ptr<ISolution> apply(const std::shared_ptr<ISolution>& solution) override;
+    std::shared_ptr<IMutation> clone() const override;
+    void setSeed(std::uint64_t seed) override;
+    
+    bool supportsMoves() const override;
+    SolutionMove propose(const ISolution& solution) override;
+    void proposeBatch(const ISolution& solution, SolutionMove* moves, int count) override;
     
     void setMoveProbability(double probability);
     void setSwapProbability(double probability);
@@ -23,10 +31,15 @@ private:
     double moveProbability_;
     double swapProbability_;
     
-    mutable std::mt19937 randomGenerator_;
+    mutable RandomGenerator randomGenerator_;
+    // Рабочий буфер выбора обмена, чтобы не выделять память на каждое предложение
+    mutable std::vector<int> nonEmptyProcessors_;
     
-    int selectRandomJob(const std::shared_ptr<ScheduleSolution>& solution) const;
-    int selectRandomProcessorExcept(const std::shared_ptr<ScheduleSolution>& solution, int excludedProcessor) const;
-    std::pair<int, int> selectTwoJobsOnDifferentProcessors(
-        const std::shared_ptr<ScheduleSolution>& solution) const;
-};
\ No newline at end of file
+    bool chooseMoveOperation() const;
+    SolutionMove proposeMoveOperation(const ScheduleSolution& solution) const;
+    int selectRandomJob(const ScheduleSolution& solution) const;
+    int selectRandomProcessorExcept(const ScheduleSolution& solution, int excludedProcessor) const;
+    std::pair<int, int> selectTwoJobsOnDifferentProcessors(const ScheduleSolution& solution) const;
+    void collectNonEmptyProcessors(const ScheduleSolution& solution) const;
+    std::pair<int, int> selectTwoJobsAmong(const ScheduleSolution& solution, const std::vector<int>& processors) const;
+};
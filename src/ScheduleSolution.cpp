@@ -1,57 +1,190 @@
 #include "ScheduleSolution.h"
 #include <stdexcept>
 #include <algorithm>
-#include <random>
-#include <chrono>
+#include <array>
+#include <limits>
+
+namespace {
+
+// Кандидаты пачки оцениваются блоками постоянной ширины: поля блока лежат в массивах на стеке,
+// а постоянное число шагов позволяет векторизовать цикл оценки уже при -O2
+constexpr int kScoreBlock = 8;
+constexpr int kExcludedCount = 3;
+
+// Три лучших элемента дерева; номера процессоров в double, как и в массивах кандидатов
+struct TopElements {
+    std::array<double, kExcludedCount> indices;
+    std::array<double, kExcludedCount> values;
+
+    explicit TopElements(const ExtremumTree& tree) {
+        std::array<int, kExcludedCount> treeIndices;
+        tree.topElements(kExcludedCount, treeIndices.data(), values.data());
+        std::copy(treeIndices.begin(), treeIndices.end(), indices.begin());
+    }
+};
+
+// Экстремум без двух процессоров кандидата: одно из трёх лучших значений дерева
+// (сравнения без сокращённого вычисления, чтобы в цикле оценки не было ветвлений)
+inline double valueExcept(const TopElements& top, double first, double second) {
+    bool keepFirst = (top.indices[0] != first) & (top.indices[0] != second);
+    bool keepSecond = (top.indices[1] != first) & (top.indices[1] != second);
+    double value = keepSecond ? top.values[1] : top.values[2];
+    return keepFirst ? top.values[0] : value;
+}
+
+}
 
 ScheduleSolution::ScheduleSolution(int jobCount, int processorCount, const std::vector<double>& jobDurations)
     : jobCount_(jobCount)
     , processorCount_(processorCount)
-    , jobDurations_(jobDurations) 
+    , jobDurations_(std::make_shared<const std::vector<double>>(jobDurations))
+    , jobProcessors_(jobCount, processorCount)
+    , processorJobs_(processorCount)
+    , jobPositions_(jobCount, -1)
+    , processorLoads_(processorCount, 0.0)
+    , processorMaxDurations_(processorCount, std::numeric_limits<double>::max())
+    , loadTree_(processorCount, ExtremumTree::Kind::Max)
+    , maxDurationTree_(processorCount, ExtremumTree::Kind::Min)
     {
-    assignmentMatrix_.resize(jobCount_);
-    for (int i = 0; i < jobCount_; ++i) {
-        assignmentMatrix_[i].resize(processorCount_, false);
+    for (int j = 0; j < processorCount_; ++j) {
+        updateProcessor(j, 0.0, std::numeric_limits<double>::max());
     }
 }
 
 ScheduleSolution::ScheduleSolution(const ScheduleSolution& other)
-    : jobCount_(other.jobCount_)
+    : ISolution(other)
+    , jobCount_(other.jobCount_)
     , processorCount_(other.processorCount_)
     , jobDurations_(other.jobDurations_)
-    , assignmentMatrix_(other.assignmentMatrix_) {
+    , jobProcessors_(other.jobProcessors_)
+    , processorJobs_(other.processorJobs_)
+    , jobPositions_(other.jobPositions_)
+    , processorLoads_(other.processorLoads_)
+    , processorMaxDurations_(other.processorMaxDurations_)
+    , loadTree_(other.loadTree_)
+    , maxDurationTree_(other.maxDurationTree_) {
 }
 
 double ScheduleSolution::evaluate() const {
-    std::vector<double> minTimes;
-    std::vector<double> maxTimes;
+    // Максимальная загрузка процессора минус минимальная (по непустым процессорам)
+    // максимальная длительность работы; пустые процессоры хранят max() и не влияют на минимум
+    return loadTree_.top() - maxDurationTree_.top();
+}
 
-    for (int j = 0; j < processorCount_; ++j) {
-        std::vector<double> orderedTimes;
-        for (int i = 0; i < jobCount_; ++i) {
-            if (assignmentMatrix_[i][j]) {
-                orderedTimes.push_back(jobDurations_[i]);
+std::shared_ptr<ISolution> ScheduleSolution::clone() const {
+    return std::make_shared<ScheduleSolution>(*this);
+}
+
+bool ScheduleSolution::supportsMoves() const {
+    return true;
+}
+
+double ScheduleSolution::evaluateMove(const SolutionMove& move) const {
+    if (move.type == SolutionMove::Type::Relocate) {
+        return evaluateMoveDelta(move.first, move.second);
+    }
+    return evaluateSwapDelta(move.first, move.second);
+}
+
+void ScheduleSolution::evaluateMoves(const SolutionMove* moves, int count, double* deltas) const {
+    // Вместо трёх запросов к каждому дереву на кандидата - три лучших элемента на всю пачку:
+    // процессоры кандидата исключают не больше двух из них
+    TopElements topLoads(loadTree_);
+    TopElements topDurations(maxDurationTree_);
+
+    const std::vector<double>& durations = *jobDurations_;
+    double currentFitness = fitness();
+
+    // Структура массивов: процессоры-участники и их загрузка и максимальная длительность после изменения
+    std::array<double, kScoreBlock> firstProcessors;
+    std::array<double, kScoreBlock> secondProcessors;
+    std::array<double, kScoreBlock> firstLoads;
+    std::array<double, kScoreBlock> secondLoads;
+    std::array<double, kScoreBlock> firstMaxDurations;
+    std::array<double, kScoreBlock> secondMaxDurations;
+    std::array<double, kScoreBlock> blockDeltas;
+
+    for (int blockBegin = 0; blockBegin < count; blockBegin += kScoreBlock) {
+        int blockSize = std::min(kScoreBlock, count - blockBegin);
+
+        // Сбор: чтения по индексам работ и процессоров, пересчёт максимума при уходе самой длинной работы
+        for (int i = 0; i < blockSize; ++i) {
+            const SolutionMove& move = moves[blockBegin + i];
+            int first;
+            int second;
+            if (move.type == SolutionMove::Type::Relocate) {
+                validateIndices(move.first, move.second);
+                first = getJobProcessor(move.first);
+                second = move.second;
+                double duration = durations[move.first];
+                firstLoads[i] = getProcessorJobCount(first) > 1 ? processorLoads_[first] - duration : 0.0;
+                secondLoads[i] = processorLoads_[second] + duration;
+                firstMaxDurations[i] = first != second ? maxDurationAfter(first, move.first, -1) : 0.0;
+                secondMaxDurations[i] = first != second ? maxDurationAfter(second, -1, move.first) : 0.0;
+            } else {
+                first = getJobProcessor(move.first);
+                second = getJobProcessor(move.second);
+                double difference = durations[move.second] - durations[move.first];
+                firstLoads[i] = processorLoads_[first] + difference;
+                secondLoads[i] = processorLoads_[second] - difference;
+                firstMaxDurations[i] = first != second ? maxDurationAfter(first, move.first, move.second) : 0.0;
+                secondMaxDurations[i] = first != second ? maxDurationAfter(second, move.second, move.first) : 0.0;
             }
+            firstProcessors[i] = first;
+            secondProcessors[i] = second;
+        }
+        // Хвост неполного блока заполняется пустыми кандидатами, их оценки не копируются
+        for (int i = blockSize; i < kScoreBlock; ++i) {
+            firstProcessors[i] = secondProcessors[i] = 0.0;
+            firstLoads[i] = secondLoads[i] = firstMaxDurations[i] = secondMaxDurations[i] = 0.0;
+        }
+
+        // Оценка: одинаковые операции над соседними элементами без ветвлений, компилятор векторизует цикл.
+        // Номера процессоров хранятся как double, чтобы все массивы имели одну ширину элемента
+        for (int i = 0; i < kScoreBlock; ++i) {
+            double first = firstProcessors[i];
+            double second = secondProcessors[i];
+            double firstLoad = firstLoads[i];
+            double secondLoad = secondLoads[i];
+            double firstMaxDuration = firstMaxDurations[i];
+            double secondMaxDuration = secondMaxDurations[i];
+
+            double maxLoad = std::max(valueExcept(topLoads, first, second), std::max(firstLoad, secondLoad));
+            double minMaxDuration = std::min(valueExcept(topDurations, first, second),
+                                             std::min(firstMaxDuration, secondMaxDuration));
+            blockDeltas[i] = (maxLoad - minMaxDuration) - currentFitness;
         }
 
-        // std::sort(orderedTimes.begin(), orderedTimes.end(), [](auto key1, auto key2) { return key1 > key2;});
-        double processorTime = 0.0;
-        for (size_t i = 0; i < orderedTimes.size(); ++i) {
-            processorTime += orderedTimes[i];
+        // Изменение внутри одного процессора решение не меняет; условие вынесено из цикла оценки,
+        // иначе вычитание уходит под ветвление и цикл не векторизуется
+        for (int i = 0; i < blockSize; ++i) {
+            deltas[blockBegin + i] = firstProcessors[i] != secondProcessors[i] ? blockDeltas[i] : 0.0;
         }
-        
-        minTimes.push_back(orderedTimes.size() > 0 ? *std::max_element(orderedTimes.begin(), orderedTimes.end()) : std::numeric_limits<double>::max());
-        maxTimes.push_back(processorTime > 0 ? processorTime : std::numeric_limits<double>::min());
     }
-    
-    double maxCompletionTime = *std::max_element(maxTimes.begin(), maxTimes.end());
-    double minCompletionTime = *std::min_element(minTimes.begin(), minTimes.end());
-    
-    return maxCompletionTime - minCompletionTime;
 }
 
-std::shared_ptr<ISolution> ScheduleSolution::clone() const {
-    return std::make_shared<ScheduleSolution>(*this);
+void ScheduleSolution::applyMove(const SolutionMove& move) {
+    if (move.type == SolutionMove::Type::Relocate) {
+        assignJobToProcessor(move.first, move.second);
+    } else {
+        swapJobs(move.first, move.second);
+    }
+}
+
+int ScheduleSolution::distanceTo(const ISolution& other) const {
+    auto otherSchedule = dynamic_cast<const ScheduleSolution*>(&other);
+    if (!otherSchedule || otherSchedule->jobCount_ != jobCount_) {
+        throw std::invalid_argument("Distance is defined only between schedules of the same size");
+    }
+
+    // Расстояние Хэмминга по отображению "работа -> процессор"
+    int distance = 0;
+    for (int i = 0; i < jobCount_; ++i) {
+        if (jobProcessors_.get(i) != otherSchedule->jobProcessors_.get(i)) {
+            ++distance;
+        }
+    }
+    return distance;
 }
 
 int ScheduleSolution::getJobCount() const {
@@ -63,42 +196,197 @@ int ScheduleSolution::getProcessorCount() const {
 }
 
 const std::vector<double>& ScheduleSolution::getJobDurations() const {
-    return jobDurations_;
+    return *jobDurations_;
 }
 
 void ScheduleSolution::assignJobToProcessor(int jobIndex, int processorIndex) {
     validateIndices(jobIndex, processorIndex);
-    
-    for (int j = 0; j < processorCount_; ++j) {
-        assignmentMatrix_[jobIndex][j] = false;
+
+    int currentProcessor = jobProcessors_.get(jobIndex);
+    if (currentProcessor == processorIndex) {
+        return;
+    }
+
+    double duration = (*jobDurations_)[jobIndex];
+
+    if (currentProcessor >= 0) {
+        bool becomesEmpty = getProcessorJobCount(currentProcessor) == 1;
+        updateProcessor(currentProcessor,
+                        becomesEmpty ? 0.0 : processorLoads_[currentProcessor] - duration,
+                        maxDurationAfter(currentProcessor, jobIndex, -1));
+    }
+
+    updateProcessor(processorIndex,
+                    processorLoads_[processorIndex] + duration,
+                    maxDurationAfter(processorIndex, -1, jobIndex));
+
+    if (currentProcessor >= 0) {
+        removeJobFromProcessor(jobIndex, currentProcessor);
     }
-    
-    assignmentMatrix_[jobIndex][processorIndex] = true;
+    addJobToProcessor(jobIndex, processorIndex);
+    jobProcessors_.set(jobIndex, processorIndex);
+    invalidateFitness();
 }
 
 bool ScheduleSolution::isJobAssignedToProcessor(int jobIndex, int processorIndex) const {
     validateIndices(jobIndex, processorIndex);
-    return assignmentMatrix_[jobIndex][processorIndex];
+    return jobProcessors_.get(jobIndex) == processorIndex;
 }
 
 int ScheduleSolution::getJobProcessor(int jobIndex) const {
     validateIndices(jobIndex, 0);
-    
-    for (int j = 0; j < processorCount_; ++j) {
-        if (assignmentMatrix_[jobIndex][j]) {
-            return j;
-        }
+
+    int processor = jobProcessors_.get(jobIndex);
+    if (processor < 0) {
+        throw std::runtime_error("Job is not assigned to any processor");
+    }
+    return processor;
+}
+
+double ScheduleSolution::evaluateMoveDelta(int jobIndex, int processorIndex) const {
+    validateIndices(jobIndex, processorIndex);
+
+    int currentProcessor = getJobProcessor(jobIndex);
+    if (currentProcessor == processorIndex) {
+        return 0.0;
+    }
+
+    double duration = (*jobDurations_)[jobIndex];
+    double sourceLoad = getProcessorJobCount(currentProcessor) > 1
+        ? processorLoads_[currentProcessor] - duration : 0.0;
+    double targetLoad = processorLoads_[processorIndex] + duration;
+
+    double maxLoad = std::max({loadTree_.topExcept(currentProcessor, processorIndex), sourceLoad, targetLoad});
+    double minMaxDuration = std::min({maxDurationTree_.topExcept(currentProcessor, processorIndex),
+                                      maxDurationAfter(currentProcessor, jobIndex, -1),
+                                      maxDurationAfter(processorIndex, -1, jobIndex)});
+
+    return (maxLoad - minMaxDuration) - fitness();
+}
+
+double ScheduleSolution::evaluateSwapDelta(int firstJobIndex, int secondJobIndex) const {
+    int firstProcessor = getJobProcessor(firstJobIndex);
+    int secondProcessor = getJobProcessor(secondJobIndex);
+    if (firstProcessor == secondProcessor) {
+        return 0.0;
+    }
+
+    double difference = (*jobDurations_)[secondJobIndex] - (*jobDurations_)[firstJobIndex];
+    double firstLoad = processorLoads_[firstProcessor] + difference;
+    double secondLoad = processorLoads_[secondProcessor] - difference;
+
+    double maxLoad = std::max({loadTree_.topExcept(firstProcessor, secondProcessor), firstLoad, secondLoad});
+    double minMaxDuration = std::min({maxDurationTree_.topExcept(firstProcessor, secondProcessor),
+                                      maxDurationAfter(firstProcessor, firstJobIndex, secondJobIndex),
+                                      maxDurationAfter(secondProcessor, secondJobIndex, firstJobIndex)});
+
+    return (maxLoad - minMaxDuration) - fitness();
+}
+
+void ScheduleSolution::swapJobs(int firstJobIndex, int secondJobIndex) {
+    int firstProcessor = getJobProcessor(firstJobIndex);
+    int secondProcessor = getJobProcessor(secondJobIndex);
+    if (firstProcessor == secondProcessor) {
+        return;
+    }
+
+    double difference = (*jobDurations_)[secondJobIndex] - (*jobDurations_)[firstJobIndex];
+    double firstMaxDuration = maxDurationAfter(firstProcessor, firstJobIndex, secondJobIndex);
+    double secondMaxDuration = maxDurationAfter(secondProcessor, secondJobIndex, firstJobIndex);
+
+    updateProcessor(firstProcessor, processorLoads_[firstProcessor] + difference, firstMaxDuration);
+    updateProcessor(secondProcessor, processorLoads_[secondProcessor] - difference, secondMaxDuration);
+
+    // Работы меняются местами в списках процессоров, размеры списков не меняются
+    processorJobs_[firstProcessor][jobPositions_[firstJobIndex]] = secondJobIndex;
+    processorJobs_[secondProcessor][jobPositions_[secondJobIndex]] = firstJobIndex;
+    std::swap(jobPositions_[firstJobIndex], jobPositions_[secondJobIndex]);
+    jobProcessors_.set(firstJobIndex, secondProcessor);
+    jobProcessors_.set(secondJobIndex, firstProcessor);
+    invalidateFitness();
+}
+
+double ScheduleSolution::getProcessorLoad(int processorIndex) const {
+    validateIndices(0, processorIndex);
+    return processorLoads_[processorIndex];
+}
+
+double ScheduleSolution::getProcessorMaxDuration(int processorIndex) const {
+    validateIndices(0, processorIndex);
+    return processorMaxDurations_[processorIndex];
+}
+
+int ScheduleSolution::getProcessorJobCount(int processorIndex) const {
+    validateIndices(0, processorIndex);
+    return static_cast<int>(processorJobs_[processorIndex].size());
+}
+
+int ScheduleSolution::getProcessorJob(int processorIndex, int position) const {
+    if (position < 0 || position >= getProcessorJobCount(processorIndex)) {
+        throw std::out_of_range("Job position out of range");
     }
-    
-    throw std::runtime_error("Job is not assigned to any processor");
+    return processorJobs_[processorIndex][position];
 }
 
 void ScheduleSolution::validateIndices(int jobIndex, int processorIndex) const {
     if (jobIndex < 0 || jobIndex >= jobCount_) {
         throw std::out_of_range("Job index out of range");
     }
-    
+
     if (processorIndex < 0 || processorIndex >= processorCount_) {
         throw std::out_of_range("Processor index out of range");
     }
 }
+
+double ScheduleSolution::maxDurationAfter(int processorIndex, int removedJob, int addedJob) const {
+    const std::vector<int>& jobs = processorJobs_[processorIndex];
+    int currentCount = static_cast<int>(jobs.size());
+    int jobCount = currentCount - (removedJob >= 0 ? 1 : 0) + (addedJob >= 0 ? 1 : 0);
+    if (jobCount == 0) {
+        return std::numeric_limits<double>::max();
+    }
+
+    const std::vector<double>& durations = *jobDurations_;
+    double result = currentCount > 0
+        ? processorMaxDurations_[processorIndex]
+        : std::numeric_limits<double>::lowest();
+
+    // Пересчёт по списку процессора нужен только когда уходит работа с максимальной длительностью
+    if (removedJob >= 0 && durations[removedJob] >= result) {
+        result = std::numeric_limits<double>::lowest();
+        for (int job : jobs) {
+            if (job != removedJob) {
+                result = std::max(result, durations[job]);
+            }
+        }
+    }
+
+    if (addedJob >= 0) {
+        result = std::max(result, durations[addedJob]);
+    }
+    return result;
+}
+
+void ScheduleSolution::updateProcessor(int processorIndex, double load, double maxDuration) {
+    processorLoads_[processorIndex] = load;
+    processorMaxDurations_[processorIndex] = maxDuration;
+    loadTree_.set(processorIndex, load);
+    maxDurationTree_.set(processorIndex, maxDuration);
+}
+
+void ScheduleSolution::removeJobFromProcessor(int jobIndex, int processorIndex) {
+    // На место уходящей работы встаёт последняя работа списка
+    std::vector<int>& jobs = processorJobs_[processorIndex];
+    int position = jobPositions_[jobIndex];
+    int lastJob = jobs.back();
+    jobs[position] = lastJob;
+    jobPositions_[lastJob] = position;
+    jobs.pop_back();
+    jobPositions_[jobIndex] = -1;
+}
+
+void ScheduleSolution::addJobToProcessor(int jobIndex, int processorIndex) {
+    std::vector<int>& jobs = processorJobs_[processorIndex];
+    jobPositions_[jobIndex] = static_cast<int>(jobs.size());
+    jobs.push_back(jobIndex);
+}
@@ -3,28 +3,61 @@
 #include <vector>
 #include <memory>
 #include "ISolution.h"
+#include "ExtremumTree.h"
+#include "ProcessorIndexArray.h"
 
 class ScheduleSolution : public ISolution {
 public:
     ScheduleSolution(int jobCount, int processorCount, const std::vector<double>& jobDurations);
     ScheduleSolution(const ScheduleSolution& other);
-    
+
     double evaluate() const override;
     std::shared_ptr<ISolution> clone() const override;
-    
+
+    bool supportsMoves() const override;
+    double evaluateMove(const SolutionMove& move) const override;
+    void evaluateMoves(const SolutionMove* moves, int count, double* deltas) const override;
+    void applyMove(const SolutionMove& move) override;
+    int distanceTo(const ISolution& other) const override;
+
     int getJobCount() const;
     int getProcessorCount() const;
     const std::vector<double>& getJobDurations() const;
-    
+
     void assignJobToProcessor(int jobIndex, int processorIndex);
     bool isJobAssignedToProcessor(int jobIndex, int processorIndex) const;
     int getJobProcessor(int jobIndex) const;
 
+    // Инкрементальные операции: изменение фитнеса без полного пересчёта
+    double evaluateMoveDelta(int jobIndex, int processorIndex) const;
+    double evaluateSwapDelta(int firstJobIndex, int secondJobIndex) const;
+    void swapJobs(int firstJobIndex, int secondJobIndex);
+
+    double getProcessorLoad(int processorIndex) const;
+    double getProcessorMaxDuration(int processorIndex) const;
+    int getProcessorJobCount(int processorIndex) const;
+    int getProcessorJob(int processorIndex, int position) const;
+
 private:
     int jobCount_;
     int processorCount_;
-    std::vector<double> jobDurations_;
-    std::vector<std::vector<bool>> assignmentMatrix_;    
+    std::shared_ptr<const std::vector<double>> jobDurations_;
+    ProcessorIndexArray jobProcessors_;
+
+    // Списки работ процессоров без порядка и позиция работы в списке своего процессора
+    // (-1 у неназначенных): перенос работы - обмен с последним элементом и добавление в конец, O(1)
+    std::vector<std::vector<int>> processorJobs_;
+    std::vector<int> jobPositions_;
+
+    // Агрегаты по процессорам: суммарная загрузка и максимальная длительность работы
+    std::vector<double> processorLoads_;
+    std::vector<double> processorMaxDurations_;
+    ExtremumTree loadTree_;
+    ExtremumTree maxDurationTree_;
 
     void validateIndices(int jobIndex, int processorIndex) const;
-};
\ No newline at end of file
+    double maxDurationAfter(int processorIndex, int removedJob, int addedJob) const;
+    void updateProcessor(int processorIndex, double load, double maxDuration);
+    void removeJobFromProcessor(int jobIndex, int processorIndex);
+    void addJobToProcessor(int jobIndex, int processorIndex);
+};
@@ -1,25 +1,64 @@
 #include "SimulatedAnnealing.h"
 #include "Logger.h"
+#include <algorithm>
 #include <cmath>
-#include <chrono>
+#include <limits>
+#include <stdexcept>
 #include <thread>
+#include <utility>
+
+namespace {
+
+constexpr size_t kAcceptanceBatch = 256;
+// Наибольшее E = -ln(1 - u) при u из [0, 1) с шагом 2^-53: ухудшение больше T * 36.74
+// не принимается ни при каком u, и случайное число для него не нужно
+const double kMaxAcceptanceVariate = 53 * std::log(2.0);
+// Часы и флаг прерывания опрашиваются раз в столько итераций: доли миллисекунды при любой скорости
+constexpr int kControlCheckIterations = 256;
+
+}
 
 SimulatedAnnealing::SimulatedAnnealing()
-    : initialTemperature_(0.0)
+    : bestFitness_(std::numeric_limits<double>::max())
+    , currentFitness_(std::numeric_limits<double>::max())
+    , initialTemperature_(0.0)
     , currentTemperature_(0.0)
     , iterationsPerTemperature_(0)
     , maxIterationsWithoutImprovement_(0)
     , isRunning_(false)
-    , shouldStop_(false) 
+    , shouldStop_(false)
+    , randomGenerator_(RandomGenerator::clockSeed())
+    , acceptanceVariates_(kAcceptanceBatch)
+    , nextAcceptanceVariate_(kAcceptanceBatch)
+    , batchSize_(1)
+    , batchSelection_(BatchSelection::FirstAccepted)
+    , rejectionFreeSampleSize_(0)
+    , rejectionFreeThreshold_(0.0)
+    , stagnationStrategy_(StagnationStrategy::Stop)
+    , maxRestarts_(0)
+    , reheatFraction_(1.0)
+    , kickMoves_(0)
+    , timeLimit_(0.0)
+    , deadline_(std::chrono::steady_clock::time_point::max())
+    , targetFitness_(std::numeric_limits<double>::lowest())
+    , interruptFlag_(nullptr)
+    , proposalsCount_(0)
+    , acceptsCount_(0)
+    , uphillAcceptsCount_(0)
+    , improvementsCount_(0)
+    , temperatureStepsCount_(0)
+    , reheatsCount_(0)
+    , eliteRestartsCount_(0)
+    , kicksCount_(0)
+    , runNanoseconds_(0)
     {
-    auto seed = std::chrono::steady_clock::now().time_since_epoch().count();
-    randomGenerator_.seed(static_cast<unsigned int>(seed));
 }
 
 void SimulatedAnnealing::setInitialSolution(const std::shared_ptr<ISolution>& solution) {
     currentSolution_ = solution->clone();
     bestSolution_ = solution->clone();
-    Logger::log("Initial solution set, fitness: " + std::to_string(solution->evaluate()));
+    bestFitness_ = solution->fitness();
+    LOG_INFO("Initial solution set, fitness: " + std::to_string(bestFitness_));
 }
 
 void SimulatedAnnealing::setMutation(const std::shared_ptr<IMutation>& mutation) {
@@ -36,31 +75,140 @@ void SimulatedAnnealing::setInitialTemperature(double temperature) {
     if (coolingLaw_) {
         coolingLaw_->initialize(temperature);
     }
-    Logger::log("Initial temperature set to: " + std::to_string(temperature));
+    LOG_INFO("Initial temperature set to: " + std::to_string(temperature));
 }
 
 void SimulatedAnnealing::setIterationsPerTemperature(int iterations) {
     iterationsPerTemperature_ = iterations;
-    Logger::log("Iterations per temperature set to: " + std::to_string(iterations));
+    LOG_INFO("Iterations per temperature set to: " + std::to_string(iterations));
 }
 
 void SimulatedAnnealing::setMaxIterationsWithoutImprovement(int iterations) {
     maxIterationsWithoutImprovement_ = iterations;
-    Logger::log("Max iterations without improvement set to: " + std::to_string(iterations));
+    LOG_INFO("Max iterations without improvement set to: " + std::to_string(iterations));
+}
+
+void SimulatedAnnealing::setBatchProposals(int batchSize, BatchSelection selection) {
+    if (batchSize <= 0) {
+        throw std::invalid_argument("Batch size must be positive");
+    }
+    batchSize_ = batchSize;
+    batchSelection_ = selection;
+    batchMoves_.resize(batchSize);
+    batchDeltas_.resize(batchSize);
+    LOG_INFO("Batch proposals set to: " + std::to_string(batchSize) +
+             (selection == BatchSelection::Best ? " (best)" : " (first accepted)"));
+}
+
+void SimulatedAnnealing::setRejectionFree(int sampleSize, double acceptanceThreshold) {
+    if (sampleSize < 0) {
+        throw std::invalid_argument("Sample size must be non-negative");
+    }
+    if (sampleSize > 0 && (acceptanceThreshold <= 0.0 || acceptanceThreshold > 1.0)) {
+        throw std::invalid_argument("Acceptance threshold must be in (0, 1]");
+    }
+    rejectionFreeSampleSize_ = sampleSize;
+    rejectionFreeThreshold_ = acceptanceThreshold;
+    sampleMoves_.resize(sampleSize);
+    sampleDeltas_.resize(sampleSize);
+    sampleWeights_.resize(sampleSize);
+    sampleTree_ = SumTree(sampleSize);
+    LOG_INFO("Rejection-free sample size set to: " + std::to_string(sampleSize) +
+             ", acceptance threshold: " + std::to_string(acceptanceThreshold));
+}
+
+void SimulatedAnnealing::setStagnationStrategy(StagnationStrategy strategy, int maxRestarts, double reheatFraction,
+                                               int kickMoves) {
+    if (maxRestarts < 0) {
+        throw std::invalid_argument("Restart count must be non-negative");
+    }
+    if (reheatFraction <= 0.0) {
+        throw std::invalid_argument("Reheat fraction must be positive");
+    }
+    if (strategy == StagnationStrategy::Kick && kickMoves <= 0) {
+        throw std::invalid_argument("Kick moves must be positive");
+    }
+    stagnationStrategy_ = strategy;
+    maxRestarts_ = maxRestarts;
+    reheatFraction_ = reheatFraction;
+    kickMoves_ = kickMoves;
+    LOG_INFO("Stagnation strategy set: max_restarts=" + std::to_string(maxRestarts) +
+             ", reheat_fraction=" + std::to_string(reheatFraction) +
+             ", kick_moves=" + std::to_string(kickMoves));
+}
+
+SimulatedAnnealing::StagnationStrategy SimulatedAnnealing::parseStagnationStrategy(const std::string& name) {
+    if (name == "stop") {
+        return StagnationStrategy::Stop;
+    }
+    if (name == "reheat") {
+        return StagnationStrategy::Reheat;
+    }
+    if (name == "elite") {
+        return StagnationStrategy::EliteRestart;
+    }
+    if (name == "kick") {
+        return StagnationStrategy::Kick;
+    }
+    throw std::invalid_argument("Unknown stagnation strategy: " + name);
+}
+
+void SimulatedAnnealing::setTimeLimit(double seconds) {
+    if (seconds < 0.0) {
+        throw std::invalid_argument("Time limit must be non-negative");
+    }
+    timeLimit_ = seconds;
+    LOG_INFO("Time limit set to: " + std::to_string(seconds) + " s");
+}
+
+void SimulatedAnnealing::setDeadline(std::chrono::steady_clock::time_point deadline) {
+    deadline_ = deadline;
+}
+
+void SimulatedAnnealing::setTargetFitness(double fitness) {
+    targetFitness_ = fitness;
+    LOG_INFO("Target fitness set to: " + std::to_string(fitness));
+}
+
+void SimulatedAnnealing::setInterruptFlag(const std::atomic<bool>* flag) {
+    interruptFlag_ = flag;
+}
+
+SimulatedAnnealing::StopReason SimulatedAnnealing::getStopReason() const {
+    return runState_.stopReason;
+}
+
+SimulatedAnnealing::BatchSelection SimulatedAnnealing::parseBatchSelection(const std::string& name) {
+    if (name == "first") {
+        return BatchSelection::FirstAccepted;
+    }
+    if (name == "best") {
+        return BatchSelection::Best;
+    }
+    throw std::invalid_argument("Unknown batch selection: " + name);
+}
+
+void SimulatedAnnealing::setSeed(std::uint64_t seed) {
+    randomGenerator_.seed(seed);
+    // Пачка от прежнего зерна отбрасывается, иначе прогон зависел бы от истории объекта
+    nextAcceptanceVariate_ = acceptanceVariates_.size();
+    LOG_INFO("Random seed set to: " + std::to_string(seed));
 }
 
 void SimulatedAnnealing::setCurrentSolution(const std::shared_ptr<ISolution>& solution) {
     if (solution) {
         currentSolution_ = solution->clone();
         
-        double newFitness = solution->evaluate();
-        double bestFitness = bestSolution_->evaluate();
+        double newFitness = solution->fitness();
+        currentFitness_ = newFitness;
+        runState_.sampleValid = false;
         
-        Logger::log("External solution set, fitness: " + std::to_string(newFitness));
+        LOG_DEBUG("External solution set, fitness: " + std::to_string(newFitness));
         
-        if (newFitness < bestFitness) {
+        if (newFitness < bestFitness_) {
             bestSolution_ = solution->clone();
-            Logger::log("NEW GLOBAL BEST from external: " + std::to_string(newFitness));
+            bestFitness_ = newFitness;
+            LOG_DEBUG("NEW GLOBAL BEST from external: " + std::to_string(newFitness));
         }
     }
 }
@@ -74,126 +222,554 @@ std::shared_ptr<ISolution> SimulatedAnnealing::getBestSolution() const {
 }
 
 double SimulatedAnnealing::getBestFitness() const {
-    return bestSolution_->evaluate();
+    return bestFitness_;
+}
+
+double SimulatedAnnealing::getCurrentFitness() const {
+    return currentFitness_;
+}
+
+double SimulatedAnnealing::getCurrentTemperature() const {
+    return currentTemperature_;
+}
+
+AnnealingMetrics SimulatedAnnealing::getMetrics() const {
+    AnnealingMetrics metrics;
+    metrics.proposals = proposalsCount_.load(std::memory_order_relaxed);
+    metrics.accepts = acceptsCount_.load(std::memory_order_relaxed);
+    metrics.uphillAccepts = uphillAcceptsCount_.load(std::memory_order_relaxed);
+    metrics.improvements = improvementsCount_.load(std::memory_order_relaxed);
+    metrics.temperatureSteps = temperatureStepsCount_.load(std::memory_order_relaxed);
+    metrics.reheats = reheatsCount_.load(std::memory_order_relaxed);
+    metrics.eliteRestarts = eliteRestartsCount_.load(std::memory_order_relaxed);
+    metrics.kicks = kicksCount_.load(std::memory_order_relaxed);
+    metrics.runSeconds = runNanoseconds_.load(std::memory_order_relaxed) * 1e-9;
+    return metrics;
+}
+
+void SimulatedAnnealing::setImprovementCallback(ImprovementCallback callback) {
+    improvementCallback_ = std::move(callback);
+}
+
+void SimulatedAnnealing::setExternalSolutionSource(SolutionSource source) {
+    externalSolutionSource_ = std::move(source);
+}
+
+void SimulatedAnnealing::setEliteSource(SolutionSource source) {
+    eliteSource_ = std::move(source);
 }
 
 void SimulatedAnnealing::stop() {
     shouldStop_ = true;
-    Logger::log("Algorithm stopped");
+    LOG_INFO("Algorithm stopped");
 }
 
 bool SimulatedAnnealing::isRunning() const {
     return isRunning_;
 }
 
-bool SimulatedAnnealing::shouldAcceptSolution(double deltaF) const {
+bool SimulatedAnnealing::shouldAcceptSolution(double deltaF) {
     if (deltaF <= 0) {
-        Logger::log("ACCEPT: Improvement deltaF=" + std::to_string(deltaF));
+        LOG_TRACE("ACCEPT: Improvement deltaF=" + std::to_string(deltaF));
         return true;
     }
+    if (deltaF >= currentTemperature_ * kMaxAcceptanceVariate) {
+        return false;
+    }
     
-    double probability = std::exp(-deltaF / currentTemperature_);
-    std::uniform_real_distribution<double> distribution(0.0, 1.0);
-    double randomValue = distribution(randomGenerator_);
-    bool accepted = randomValue < probability;
+    if (nextAcceptanceVariate_ == acceptanceVariates_.size()) {
+        refillAcceptanceVariates();
+    }
+    double threshold = currentTemperature_ * acceptanceVariates_[nextAcceptanceVariate_++];
+    bool accepted = deltaF < threshold;
     
-    Logger::log("DECISION: deltaF=" + std::to_string(deltaF) + 
-                ", T=" + std::to_string(currentTemperature_) +
-                ", probability=" + std::to_string(probability) +
-                ", random=" + std::to_string(randomValue) +
-                ", accepted=" + std::to_string(accepted));
+    LOG_TRACE("DECISION: deltaF=" + std::to_string(deltaF) + 
+              ", T=" + std::to_string(currentTemperature_) +
+              ", threshold=" + std::to_string(threshold) +
+              ", accepted=" + std::to_string(accepted));
     
     return accepted;
 }
 
+void SimulatedAnnealing::refillAcceptanceVariates() {
+    for (double& variate : acceptanceVariates_) {
+        variate = -std::log(1.0 - randomGenerator_.nextDouble());
+    }
+    nextAcceptanceVariate_ = 0;
+}
+
 std::shared_ptr<ISolution> SimulatedAnnealing::run() {
-    if (!currentSolution_ || !mutation_ || !coolingLaw_) {
-        Logger::log("ERROR: Algorithm not properly initialized");
+    if (!start()) {
         return nullptr;
     }
     
+    advance(std::numeric_limits<long long>::max());
+    
+    return bestSolution_;
+}
+
+bool SimulatedAnnealing::start() {
+    if (!currentSolution_ || !mutation_ || !coolingLaw_) {
+        LOG_INFO("ERROR: Algorithm not properly initialized");
+        return false;
+    }
+    
     isRunning_ = true;
     shouldStop_ = false;
     
-    int iterationsWithoutImprovement = 0;
-    int totalIteration = 0;
-    
-    double initialFitness;
     bestSolution_ = currentSolution_->clone();
-    initialFitness = bestSolution_->evaluate();
+    bestFitness_ = currentSolution_->fitness();
+    currentFitness_ = bestFitness_;
     
-    double bestFitness = initialFitness;
+    runState_ = RunState();
+    runState_.initialFitness = bestFitness_;
+    // Перезапуск начинает кривую охлаждения заново с T0, а не с температуры, на которой остановился
+    // прошлый прогон; адаптивные законы сбрасывают накопленное состояние
+    if (initialTemperature_ > 0) {
+        currentTemperature_ = initialTemperature_;
+        coolingLaw_->initialize(initialTemperature_);
+    }
+    // Если решение и мутация поддерживают изменения на месте, отвергнутые
+    // предложения не требуют ни копирования решения, ни выделения памяти
+    runState_.inPlace = currentSolution_->supportsMoves() && mutation_->supportsMoves();
+    runState_.lastPublish = std::chrono::steady_clock::now();
+    // Срок от start() действует и на этот перезапуск, абсолютный срок - на все
+    runState_.deadline = deadline_;
+    if (timeLimit_ > 0.0) {
+        auto limit = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(timeLimit_));
+        runState_.deadline = std::min(runState_.deadline, runState_.lastPublish + limit);
+    }
+    // Начальное решение уже достигает цели: advance() сразу вернёт его
+    if (bestFitness_ <= targetFitness_) {
+        runState_.stopReason = StopReason::TargetReached;
+        shouldStop_ = true;
+    }
     
-    Logger::log("Algorithm STARTED: T0=" + std::to_string(initialTemperature_) +
-                ", iterations_per_temp=" + std::to_string(iterationsPerTemperature_) +
-                ", max_no_improve=" + std::to_string(maxIterationsWithoutImprovement_) +
-                ", initial_fitness=" + std::to_string(initialFitness));
+    LOG_INFO("Algorithm STARTED: T0=" + std::to_string(initialTemperature_) +
+             ", iterations_per_temp=" + std::to_string(iterationsPerTemperature_) +
+             ", max_no_improve=" + std::to_string(maxIterationsWithoutImprovement_) +
+             ", initial_fitness=" + std::to_string(runState_.initialFitness) +
+             ", in_place=" + std::to_string(runState_.inPlace));
     
-    while (iterationsWithoutImprovement < maxIterationsWithoutImprovement_ && !shouldStop_) {
-        if (shouldStop_) break;
-        
-        bool improvedInThisCycle = false;
+    return true;
+}
+
+bool SimulatedAnnealing::advance(long long maxIterations) {
+    if (!isRunning_) {
+        return true;
+    }
+    
+    RunState& state = runState_;
+    state.lastPublish = std::chrono::steady_clock::now();
+    long long iterationsDone = 0;
+    bool finished = false;
+    
+    while (!finished && !shouldStop_) {
+        if (state.cycleIteration == 0 && state.iterationsWithoutImprovement >= maxIterationsWithoutImprovement_ &&
+            !handleStagnation()) {
+            finished = true;
+            break;
+        }
         
-        for (int i = 0; i < iterationsPerTemperature_ && !shouldStop_; ++i) {
-            if (shouldStop_) break;
-            
-            auto newSolution = mutation_->apply(currentSolution_);
-            
-            double currentFitness, newFitness;
-            currentFitness = currentSolution_->evaluate();
-            newFitness = newSolution->evaluate();
-            
-            double deltaF = newFitness - currentFitness;
+        while (state.cycleIteration < iterationsPerTemperature_ && !shouldStop_) {
+            // Пауза посреди цикла температуры: состояние сохранено, следующий advance() продолжит отсюда
+            if (iterationsDone >= maxIterations) {
+                publishMetrics(state.pendingMetrics, state.lastPublish);
+                return false;
+            }
             
-            if (shouldAcceptSolution(deltaF)) {
-                currentSolution_ = newSolution;
-                
-                if (newFitness < bestFitness) {
-                    // std::cout << "Fitness improved to : " << newFitness << std::endl;
-                    bestSolution_ = newSolution->clone();
-                    bestFitness = newFitness;
-                    improvedInThisCycle = true;
-                    
-                    Logger::log("NEW BEST: fitness improved to " + std::to_string(newFitness) +
-                                " (iteration " + std::to_string(totalIteration) + ")");
+            if (state.totalIteration >= state.nextControlCheck) {
+                state.nextControlCheck = state.totalIteration + kControlCheckIterations;
+                if (checkInterruption()) {
+                    break;
                 }
             }
             
-            ++totalIteration;
-            
-            if (totalIteration % 100 == 0) {
-                Logger::log("Progress: iteration=" + std::to_string(totalIteration) +
-                            ", current_fitness=" + std::to_string(currentFitness) +
-                            ", best_fitness=" + std::to_string(bestFitness) +
-                            ", T=" + std::to_string(currentTemperature_));
+            // Шаг не выходит за цикл температуры и за бюджет advance()
+            int limit = static_cast<int>(std::min<long long>(iterationsPerTemperature_ - state.cycleIteration,
+                                                             maxIterations - iterationsDone));
+            int steps;
+            if (state.rejectionFree) {
+                steps = runRejectionFreeStep(limit);
+            } else if (state.inPlace && batchSize_ > 1) {
+                steps = runBatchStep(std::min(batchSize_, limit));
+            } else {
+                steps = runSingleStep();
             }
+            iterationsDone += steps;
+            state.cycleIteration += steps;
         }
         
-        if (improvedInThisCycle) {
-            iterationsWithoutImprovement = 0;
-            Logger::log("Temperature cycle: IMPROVEMENT found");
+        if (shouldStop_) {
+            break;
+        }
+        
+        if (state.improvedInThisCycle) {
+            state.iterationsWithoutImprovement = 0;
+            LOG_DEBUG("Temperature cycle: IMPROVEMENT found");
         } else {
-            ++iterationsWithoutImprovement;
-            Logger::log("Temperature cycle: NO improvement, count=" + 
-                        std::to_string(iterationsWithoutImprovement));
+            ++state.iterationsWithoutImprovement;
+            LOG_DEBUG("Temperature cycle: NO improvement, count=" + 
+                      std::to_string(state.iterationsWithoutImprovement));
+        }
+        
+        // Почти все предложения отвергаются: дальше ходы выбираются сразу среди принимаемых
+        if (!state.rejectionFree && rejectionFreeSampleSize_ > 0 && state.inPlace &&
+            state.cycleAccepts < rejectionFreeThreshold_ * iterationsPerTemperature_) {
+            state.rejectionFree = true;
+            LOG_INFO("Switching to rejection-free moves: T=" + std::to_string(currentTemperature_) +
+                     ", cycle_accepts=" + std::to_string(state.cycleAccepts));
         }
         
         double oldTemperature = currentTemperature_;
-        currentTemperature_ = coolingLaw_->cool(totalIteration);
-        Logger::log("Temperature cooled: " + std::to_string(oldTemperature) + 
-                    " -> " + std::to_string(currentTemperature_));
+        currentTemperature_ = coolingLaw_->update(state.totalIteration - state.coolingStart, collectCoolingFeedback());
+        LOG_DEBUG("Temperature cooled: " + std::to_string(oldTemperature) + 
+                  " -> " + std::to_string(currentTemperature_));
+        
+        state.improvedInThisCycle = false;
+        state.cycleIteration = 0;
+        state.cycleAccepts = 0;
+        state.cycleDeltas = Moments();
+        state.cycleFitness = Moments();
+        // На новой температуре соседи выбираются заново, иначе цепь была бы заперта в одной выборке
+        state.sampleValid = false;
+        
+        ++state.pendingMetrics.temperatureSteps;
+        publishMetrics(state.pendingMetrics, state.lastPublish);
+        
+        if (externalSolutionSource_) {
+            auto external = externalSolutionSource_();
+            if (external && external->fitness() < bestFitness_) {
+                setCurrentSolution(external);
+            }
+        }
         
         if (currentTemperature_ < 1e-10) {
-            Logger::log("Stopping: temperature below threshold");
-            break;
+            LOG_INFO("Temperature below threshold: T=" + std::to_string(currentTemperature_));
+            finished = !handleStagnation();
         }
     }
     
+    publishMetrics(state.pendingMetrics, state.lastPublish);
     isRunning_ = false;
+    if (state.stopReason == StopReason::None) {
+        state.stopReason = finished ? StopReason::Finished : StopReason::Stopped;
+    }
     
-    Logger::log("Algorithm FINISHED: total_iterations=" + std::to_string(totalIteration) +
-                ", final_fitness=" + std::to_string(bestFitness) +
-                ", improvement=" + std::to_string(initialFitness - bestFitness));
+    LOG_INFO("Algorithm FINISHED: total_iterations=" + std::to_string(state.totalIteration) +
+             ", final_fitness=" + std::to_string(bestFitness_) +
+             ", improvement=" + std::to_string(state.initialFitness - bestFitness_));
     
-    return bestSolution_;
+    return true;
+}
+
+int SimulatedAnnealing::runSingleStep() {
+    RunState& state = runState_;
+    double deltaF;
+    
+    SolutionMove move{};
+    std::shared_ptr<ISolution> newSolution;
+    if (state.inPlace) {
+        move = mutation_->propose(*currentSolution_);
+        deltaF = currentSolution_->evaluateMove(move);
+    } else {
+        newSolution = mutation_->apply(currentSolution_);
+        deltaF = newSolution->fitness() - currentFitness_;
+    }
+    
+    ++state.pendingMetrics.proposals;
+    
+    if (shouldAcceptSolution(deltaF)) {
+        if (state.inPlace) {
+            currentSolution_->applyMove(move);
+        } else {
+            currentSolution_ = newSolution;
+        }
+        recordAcceptance(deltaF);
+    }
+    
+    state.cycleDeltas.add(deltaF);
+    state.cycleFitness.add(currentFitness_);
+    countIterations(1);
+    return 1;
+}
+
+int SimulatedAnnealing::runBatchStep(int count) {
+    RunState& state = runState_;
+    mutation_->proposeBatch(*currentSolution_, batchMoves_.data(), count);
+    currentSolution_->evaluateMoves(batchMoves_.data(), count, batchDeltas_.data());
+    
+    if (batchSelection_ == BatchSelection::Best) {
+        // Лучший из count кандидатов проходит критерий Метрополиса; все кандидаты считаются итерациями
+        int best = static_cast<int>(std::min_element(batchDeltas_.begin(), batchDeltas_.begin() + count) -
+                                    batchDeltas_.begin());
+        state.pendingMetrics.proposals += count;
+        for (int i = 0; i < count; ++i) {
+            state.cycleDeltas.add(batchDeltas_[i]);
+        }
+        if (shouldAcceptSolution(batchDeltas_[best])) {
+            currentSolution_->applyMove(batchMoves_[best]);
+            recordAcceptance(batchDeltas_[best]);
+        }
+        state.cycleFitness.add(currentFitness_, count);
+        countIterations(count);
+        return count;
+    }
+    
+    // Кандидаты проверяются по порядку, как при одиночных шагах; после принятого
+    // остальные оценены для прежнего решения и отбрасываются, итерациями не считаясь
+    for (int i = 0; i < count; ++i) {
+        ++state.pendingMetrics.proposals;
+        state.cycleDeltas.add(batchDeltas_[i]);
+        countIterations(1);
+        if (shouldAcceptSolution(batchDeltas_[i])) {
+            currentSolution_->applyMove(batchMoves_[i]);
+            recordAcceptance(batchDeltas_[i]);
+            state.cycleFitness.add(currentFitness_);
+            return i + 1;
+        }
+        state.cycleFitness.add(currentFitness_);
+    }
+    return count;
+}
+
+int SimulatedAnnealing::runRejectionFreeStep(int limit) {
+    RunState& state = runState_;
+    int sampleSize = rejectionFreeSampleSize_;
+    
+    if (!state.sampleValid) {
+        mutation_->proposeBatch(*currentSolution_, sampleMoves_.data(), sampleSize);
+        currentSolution_->evaluateMoves(sampleMoves_.data(), sampleSize, sampleDeltas_.data());
+        for (int i = 0; i < sampleSize; ++i) {
+            sampleWeights_[i] = sampleDeltas_[i] <= 0 ? 1.0 : std::exp(-sampleDeltas_[i] / currentTemperature_);
+        }
+        sampleTree_.assign(sampleWeights_);
+        state.sampleValid = true;
+        // Выборка - те же равновероятные предложения, что и у обычных шагов
+        for (int i = 0; i < sampleSize; ++i) {
+            state.cycleDeltas.add(sampleDeltas_[i]);
+        }
+    }
+    
+    // Выборка заменяет не больше sampleSize обычных итераций: каждая из них взяла бы одного нового
+    // кандидата. Вероятность принять случайного кандидата выборки - W / sampleSize, число отказов
+    // до принятия распределено геометрически
+    int window = std::min(limit, sampleSize);
+    double acceptance = sampleTree_.total() / sampleSize;
+    int rejections = window;
+    if (acceptance >= 1.0) {
+        rejections = 0;
+    } else if (acceptance > 0.0) {
+        double waiting = std::floor(std::log(1.0 - randomGenerator_.nextDouble()) / std::log1p(-acceptance));
+        if (waiting < window) {
+            rejections = static_cast<int>(waiting);
+        }
+    }
+    
+    if (rejections >= window) {
+        // Все итерации окна отвергнуты, решение не меняется. Исчерпанная выборка набирается
+        // заново; окно, обрезанное концом цикла или бюджетом advance(), её не исчерпывает
+        state.pendingMetrics.proposals += window;
+        state.cycleFitness.add(currentFitness_, window);
+        countIterations(window);
+        if (window == sampleSize) {
+            state.sampleValid = false;
+        }
+        return window;
+    }
+    
+    int chosen = sampleTree_.find(randomGenerator_.nextDouble() * sampleTree_.total());
+    SolutionMove move = sampleMoves_[chosen];
+    double deltaF = sampleDeltas_[chosen];
+    if (rejections > 0) {
+        state.cycleFitness.add(currentFitness_, rejections);
+    }
+    currentSolution_->applyMove(move);
+    state.pendingMetrics.proposals += rejections + 1;
+    recordAcceptance(deltaF);
+    state.cycleFitness.add(currentFitness_);
+    countIterations(rejections + 1);
+    
+    // Веса всех кандидатов зависят от глобальных максимума и минимума, а оставшиеся в выборке
+    // смещены к отвергаемым ходам (принимаемые уходят первыми), поэтому после хода она набирается заново
+    state.sampleValid = false;
+    return rejections + 1;
+}
+
+void SimulatedAnnealing::recordAcceptance(double deltaF) {
+    RunState& state = runState_;
+    ++state.pendingMetrics.accepts;
+    ++state.cycleAccepts;
+    if (deltaF > 0) {
+        ++state.pendingMetrics.uphillAccepts;
+    }
+    currentFitness_ = currentSolution_->fitness();
+    updateBestSolution();
+}
+
+void SimulatedAnnealing::updateBestSolution() {
+    RunState& state = runState_;
+    if (currentFitness_ < bestFitness_) {
+        bestSolution_ = currentSolution_->clone();
+        bestFitness_ = currentFitness_;
+        state.improvedInThisCycle = true;
+        ++state.pendingMetrics.improvements;
+        
+        LOG_DEBUG("NEW BEST: fitness improved to " + std::to_string(currentFitness_) +
+                  " (iteration " + std::to_string(state.totalIteration) + ")");
+        
+        if (improvementCallback_) {
+            improvementCallback_(bestSolution_, bestFitness_);
+        }
+        
+        if (bestFitness_ <= targetFitness_) {
+            LOG_INFO("Target fitness reached: " + std::to_string(bestFitness_));
+            state.stopReason = StopReason::TargetReached;
+            shouldStop_ = true;
+        }
+    }
+}
+
+bool SimulatedAnnealing::checkInterruption() {
+    RunState& state = runState_;
+    if (interruptFlag_ && interruptFlag_->load(std::memory_order_relaxed)) {
+        LOG_INFO("Interrupted: returning best solution so far");
+        state.stopReason = StopReason::Interrupted;
+    } else if (state.deadline != std::chrono::steady_clock::time_point::max() &&
+               std::chrono::steady_clock::now() >= state.deadline) {
+        LOG_INFO("Time limit reached: returning best solution so far");
+        state.stopReason = StopReason::Deadline;
+    } else {
+        return false;
+    }
+    shouldStop_ = true;
+    return true;
+}
+
+bool SimulatedAnnealing::handleStagnation() {
+    RunState& state = runState_;
+    if (stagnationStrategy_ == StagnationStrategy::Stop || state.restarts >= maxRestarts_ || initialTemperature_ <= 0) {
+        return false;
+    }
+    ++state.restarts;
+    
+    switch (stagnationStrategy_) {
+    case StagnationStrategy::Stop:
+        break;
+    case StagnationStrategy::Reheat:
+        // Текущее решение сохраняется, меняется только температура
+        ++state.pendingMetrics.reheats;
+        break;
+    case StagnationStrategy::EliteRestart: {
+        auto elite = eliteSource_ ? eliteSource_() : nullptr;
+        adoptRestartSolution(elite ? elite->clone() : bestSolution_->clone());
+        ++state.pendingMetrics.eliteRestarts;
+        break;
+    }
+    case StagnationStrategy::Kick: {
+        // Встряска лучшего решения: случайные ходы применяются без критерия Метрополиса
+        auto kicked = bestSolution_->clone();
+        for (int i = 0; i < kickMoves_; ++i) {
+            if (state.inPlace) {
+                kicked->applyMove(mutation_->propose(*kicked));
+            } else {
+                kicked = mutation_->apply(kicked);
+            }
+        }
+        adoptRestartSolution(kicked);
+        ++state.pendingMetrics.kicks;
+        break;
+    }
+    }
+    
+    // Новая кривая охлаждения: закон начинает с начала, застой и режим без отказов сбрасываются
+    currentTemperature_ = reheatFraction_ * initialTemperature_;
+    coolingLaw_->initialize(currentTemperature_);
+    state.coolingStart = state.totalIteration;
+    state.iterationsWithoutImprovement = 0;
+    state.rejectionFree = false;
+    state.sampleValid = false;
+    
+    LOG_INFO("Stagnation restart " + std::to_string(state.restarts) + "/" + std::to_string(maxRestarts_) +
+             ": T=" + std::to_string(currentTemperature_) +
+             ", current_fitness=" + std::to_string(currentFitness_) +
+             ", best_fitness=" + std::to_string(bestFitness_));
+    return true;
+}
+
+void SimulatedAnnealing::adoptRestartSolution(const std::shared_ptr<ISolution>& solution) {
+    // Элитное решение из другого потока может оказаться лучше своего
+    currentSolution_ = solution;
+    currentFitness_ = currentSolution_->fitness();
+    updateBestSolution();
+}
+
+void SimulatedAnnealing::countIterations(int count) {
+    RunState& state = runState_;
+    int previous = state.totalIteration;
+    state.totalIteration += count;
+    
+    if (state.totalIteration / 100 != previous / 100) {
+        LOG_DEBUG("Progress: iteration=" + std::to_string(state.totalIteration) +
+                  ", current_fitness=" + std::to_string(currentFitness_) +
+                  ", best_fitness=" + std::to_string(bestFitness_) +
+                  ", T=" + std::to_string(currentTemperature_));
+    }
+}
+
+CoolingFeedback SimulatedAnnealing::collectCoolingFeedback() const {
+    const RunState& state = runState_;
+    CoolingFeedback feedback;
+    feedback.temperature = currentTemperature_;
+    feedback.proposals = iterationsPerTemperature_;
+    feedback.accepts = state.cycleAccepts;
+    feedback.meanDelta = state.cycleDeltas.mean();
+    feedback.deltaVariance = state.cycleDeltas.variance();
+    feedback.meanFitness = state.cycleFitness.mean();
+    feedback.fitnessVariance = state.cycleFitness.variance();
+    feedback.currentFitness = currentFitness_;
+    feedback.bestFitness = bestFitness_;
+    feedback.improved = state.improvedInThisCycle;
+    feedback.stepsWithoutImprovement = state.iterationsWithoutImprovement;
+    return feedback;
+}
+
+void SimulatedAnnealing::Moments::add(double value, double count) {
+    if (weight == 0.0) {
+        shift = value;
+    }
+    double offset = value - shift;
+    weight += count;
+    sum += count * offset;
+    sumSquares += count * offset * offset;
+}
+
+double SimulatedAnnealing::Moments::mean() const {
+    return weight > 0.0 ? shift + sum / weight : 0.0;
+}
+
+double SimulatedAnnealing::Moments::variance() const {
+    if (weight <= 0.0) {
+        return 0.0;
+    }
+    double offsetMean = sum / weight;
+    return std::max(0.0, sumSquares / weight - offsetMean * offsetMean);
+}
+
+void SimulatedAnnealing::publishMetrics(AnnealingMetrics& pending,
+                                        std::chrono::steady_clock::time_point& lastPublish) {
+    auto now = std::chrono::steady_clock::now();
+    runNanoseconds_.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(now - lastPublish).count(),
+                              std::memory_order_relaxed);
+    lastPublish = now;
+    
+    proposalsCount_.fetch_add(pending.proposals, std::memory_order_relaxed);
+    acceptsCount_.fetch_add(pending.accepts, std::memory_order_relaxed);
+    uphillAcceptsCount_.fetch_add(pending.uphillAccepts, std::memory_order_relaxed);
+    improvementsCount_.fetch_add(pending.improvements, std::memory_order_relaxed);
+    temperatureStepsCount_.fetch_add(pending.temperatureSteps, std::memory_order_relaxed);
+    reheatsCount_.fetch_add(pending.reheats, std::memory_order_relaxed);
+    eliteRestartsCount_.fetch_add(pending.eliteRestarts, std::memory_order_relaxed);
+    kicksCount_.fetch_add(pending.kicks, std::memory_order_relaxed);
+    pending = AnnealingMetrics();
 }
\ No newline at end of file
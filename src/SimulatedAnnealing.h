@@ -1,16 +1,32 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
-#include <random>
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
+#include <functional>
+#include <string>
+#include <vector>
 #include "ISolution.h"
 #include "IMutation.h"
 #include "ICoolingLaw.h"
+#include "RandomGenerator.h"
+#include "AnnealingMetrics.h"
+#include "SumTree.h"
 
 class SimulatedAnnealing {
 public:
+    // Выбор из пачки кандидатов: первый принятый по порядку или лучший из пачки
+    enum class BatchSelection { FirstAccepted, Best };
+    // Реакция на застой (maxIterationsWithoutImprovement шагов температуры без улучшения или
+    // температура ниже порога): остановка, повторный нагрев текущего решения, перезапуск из
+    // элитного решения или встряска лучшего решения случайными ходами (итерированный локальный поиск)
+    enum class StagnationStrategy { Stop, Reheat, EliteRestart, Kick };
+    // Причина завершения последнего прогона: обычное окончание, срок, достигнутая цель, прерывание или stop()
+    enum class StopReason { None, Finished, Deadline, TargetReached, Interrupted, Stopped };
+    
     SimulatedAnnealing();
     
     void setInitialSolution(const std::shared_ptr<ISolution>& solution);
@@ -19,23 +35,72 @@ public:
     void setInitialTemperature(double temperature);
     void setIterationsPerTemperature(int iterations);
     void setMaxIterationsWithoutImprovement(int iterations);
+    void setSeed(std::uint64_t seed);
+    // Пакетные предложения: batchSize кандидатов генерируются и оцениваются разом для одного
+    // решения (только при изменениях на месте); 1 - обычные одиночные шаги
+    void setBatchProposals(int batchSize, BatchSelection selection);
+    static BatchSelection parseBatchSelection(const std::string& name);
+    // Режим без отказов для низких температур: включается, когда доля принятых предложений
+    // за шаг температуры падает ниже acceptanceThreshold; sampleSize - размер выборки соседей, 0 - выключен.
+    // Выборка набирается заново после каждого хода, поэтому выгоднее всего sampleSize порядка 1 / acceptanceThreshold
+    void setRejectionFree(int sampleSize, double acceptanceThreshold);
+    // После каждой реакции кривая охлаждения начинается заново с reheatFraction * T0, счётчик застоя
+    // и режим без отказов сбрасываются; прогон завершается, когда исчерпаны maxRestarts реакций.
+    // kickMoves - число случайных ходов встряски
+    void setStagnationStrategy(StagnationStrategy strategy, int maxRestarts, double reheatFraction, int kickMoves);
+    static StagnationStrategy parseStagnationStrategy(const std::string& name);
+    
+    // Режим с ограничением по времени: прогон возвращает лучшее найденное решение, когда истекает срок,
+    // достигнута целевая пригодность или выставлен внешний флаг прерывания (например, из обработчика сигнала).
+    // Часы и флаг проверяются раз в несколько сотен итераций; timeLimit отсчитывается от start(), 0 - без ограничения
+    void setTimeLimit(double seconds);
+    void setDeadline(std::chrono::steady_clock::time_point deadline);
+    void setTargetFitness(double fitness);
+    void setInterruptFlag(const std::atomic<bool>* flag);
+    StopReason getStopReason() const;
     
     // Новые методы для многопоточности
     void setCurrentSolution(const std::shared_ptr<ISolution>& solution);
     std::shared_ptr<ISolution> getCurrentSolution() const;
     std::shared_ptr<ISolution> getBestSolution() const;
     double getBestFitness() const;
+    double getCurrentFitness() const;
+    double getCurrentTemperature() const;
+    AnnealingMetrics getMetrics() const;
+    
+    // Обмен во время прогона: callback получает каждое новое лучшее решение (объект
+    // больше не изменяется алгоритмом), источник опрашивается на каждом шаге температуры
+    // и может вернуть внешнее решение, которое заменит текущее, если лучше найденного
+    using ImprovementCallback = std::function<void(const std::shared_ptr<ISolution>&, double)>;
+    using SolutionSource = std::function<std::shared_ptr<ISolution>()>;
+    void setImprovementCallback(ImprovementCallback callback);
+    void setExternalSolutionSource(SolutionSource source);
+    // Элитное решение для перезапуска при застое; без источника - лучшее решение этого объекта
+    void setEliteSource(SolutionSource source);
     
     void stop();
     bool isRunning() const;
     
     std::shared_ptr<ISolution> run();
+    
+    // Пошаговый запуск: start() начинает прогон с текущего решения, advance() выполняет
+    // не более maxIterations итераций и возвращает true, когда прогон завершён
+    bool start();
+    bool advance(long long maxIterations);
+    
+    // Критерий Метрополиса при текущей температуре; ухудшение расходует одну случайную величину генератора
+    bool shouldAcceptSolution(double deltaF);
 
 private:
     std::shared_ptr<ISolution> currentSolution_;
     std::shared_ptr<ISolution> bestSolution_;
+    double bestFitness_;
+    double currentFitness_;
     std::shared_ptr<IMutation> mutation_;
     std::shared_ptr<ICoolingLaw> coolingLaw_;
+    ImprovementCallback improvementCallback_;
+    SolutionSource externalSolutionSource_;
+    SolutionSource eliteSource_;
     
     double initialTemperature_;
     double currentTemperature_;
@@ -45,7 +110,104 @@ private:
     std::atomic<bool> isRunning_;
     std::atomic<bool> shouldStop_;
     
-    mutable std::mt19937 randomGenerator_;
+    mutable RandomGenerator randomGenerator_;
+    
+    // Критерий Метрополиса без exp: u < exp(-dF/T) равносильно dF < T * E, где E = -ln(1 - u)
+    // экспоненциально распределено и от температуры не зависит. E считаются пачками, чтобы
+    // логарифмы шли подряд без ветвлений горячего цикла между ними
+    std::vector<double> acceptanceVariates_;
+    size_t nextAcceptanceVariate_;
+    
+    int batchSize_;
+    BatchSelection batchSelection_;
+    std::vector<SolutionMove> batchMoves_;
+    std::vector<double> batchDeltas_;
+    
+    // Режим без отказов (n-fold way): ход выбирается из выборки соседей с вероятностью,
+    // пропорциональной min(1, exp(-dF/T)), а число отказов, которые обычный отжиг сделал бы
+    // до него, разыгрывается по геометрическому закону. Так моделируется та же цепь, что и
+    // у обычных шагов с равновероятным выбором кандидата из выборки
+    int rejectionFreeSampleSize_;
+    double rejectionFreeThreshold_;
+    std::vector<SolutionMove> sampleMoves_;
+    std::vector<double> sampleDeltas_;
+    std::vector<double> sampleWeights_;
+    SumTree sampleTree_;
+    
+    StagnationStrategy stagnationStrategy_;
+    int maxRestarts_;
+    double reheatFraction_;
+    int kickMoves_;
+    
+    double timeLimit_;
+    std::chrono::steady_clock::time_point deadline_;
+    double targetFitness_;
+    const std::atomic<bool>* interruptFlag_;
+    
+    // Сдвинутые суммы для среднего и дисперсии за шаг температуры: сдвиг на первое значение
+    // сохраняет точность, когда фитнес велик, а разброс мал
+    struct Moments {
+        double shift = 0.0;
+        double weight = 0.0;
+        double sum = 0.0;
+        double sumSquares = 0.0;
+        
+        void add(double value, double count = 1.0);
+        double mean() const;
+        double variance() const;
+    };
+    
+    // Состояние прогона между вызовами advance()
+    struct RunState {
+        int iterationsWithoutImprovement = 0;
+        int totalIteration = 0;
+        int cycleIteration = 0;
+        bool improvedInThisCycle = false;
+        bool inPlace = false;
+        // Реакции на застой за прогон; итерация, с которой начата текущая кривая охлаждения
+        int restarts = 0;
+        int coolingStart = 0;
+        // Срок прогона и итерация следующей проверки срока и флага прерывания
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+        int nextControlCheck = 0;
+        StopReason stopReason = StopReason::None;
+        // Наблюдения за текущим шагом температуры для адаптивных законов охлаждения
+        int cycleAccepts = 0;
+        Moments cycleDeltas;
+        Moments cycleFitness;
+        // Режим без отказов включён; выборка соседей набрана и оценена для текущего решения и температуры
+        bool rejectionFree = false;
+        bool sampleValid = false;
+        double initialFitness = 0.0;
+        AnnealingMetrics pendingMetrics;
+        std::chrono::steady_clock::time_point lastPublish;
+    };
+    RunState runState_;
+    
+    // Счётчики копятся в RunState и публикуются раз в шаг температуры
+    std::atomic<std::uint64_t> proposalsCount_;
+    std::atomic<std::uint64_t> acceptsCount_;
+    std::atomic<std::uint64_t> uphillAcceptsCount_;
+    std::atomic<std::uint64_t> improvementsCount_;
+    std::atomic<std::uint64_t> temperatureStepsCount_;
+    std::atomic<std::uint64_t> reheatsCount_;
+    std::atomic<std::uint64_t> eliteRestartsCount_;
+    std::atomic<std::uint64_t> kicksCount_;
+    std::atomic<std::int64_t> runNanoseconds_;
     
-    bool shouldAcceptSolution(double deltaF) const;
+    void refillAcceptanceVariates();
+    // Шаги горячего цикла; возвращают число израсходованных итераций
+    int runSingleStep();
+    int runBatchStep(int count);
+    int runRejectionFreeStep(int limit);
+    void recordAcceptance(double deltaF);
+    void updateBestSolution();
+    // false - реакции исчерпаны или не заданы, прогон завершается
+    bool handleStagnation();
+    // true - срок истёк или выставлен флаг прерывания
+    bool checkInterruption();
+    void adoptRestartSolution(const std::shared_ptr<ISolution>& solution);
+    void countIterations(int count);
+    CoolingFeedback collectCoolingFeedback() const;
+    void publishMetrics(AnnealingMetrics& pending, std::chrono::steady_clock::time_point& lastPublish);
 };
\ No newline at end of file
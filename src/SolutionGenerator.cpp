@@ -1,13 +1,15 @@
 #include "SolutionGenerator.h"
 #include <random>
-#include <chrono>
 #include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
 #include <stdexcept>
 
 std::shared_ptr<ScheduleSolution> SolutionGenerator::generateRandomSolution(
-    int jobCount, int processorCount, const std::vector<double>& jobDurations) {
+    int jobCount, int processorCount, const std::vector<double>& jobDurations, std::uint64_t seed) {
     
-    auto assignment = generateRandomAssignment(jobCount, processorCount);
+    auto assignment = generateRandomAssignment(jobCount, processorCount, seed);
     auto solution = std::make_shared<ScheduleSolution>(jobCount, processorCount, jobDurations);
     
     for (int i = 0; i < jobCount; ++i) {
@@ -30,13 +32,12 @@ std::shared_ptr<ScheduleSolution> SolutionGenerator::generateWorstCaseSolution(
     return solution;
 }
 
-std::vector<int> SolutionGenerator::generateRandomAssignment(int jobCount, int processorCount) {
+std::vector<int> SolutionGenerator::generateRandomAssignment(int jobCount, int processorCount, std::uint64_t seed) {
     if (jobCount <= 0 || processorCount <= 0) {
         throw std::invalid_argument("Job count and processor count must be positive");
     }
     
-    auto seed = std::chrono::steady_clock::now().time_since_epoch().count();
-    std::mt19937 generator(static_cast<unsigned int>(seed));
+    RandomGenerator generator(seed);
     std::uniform_int_distribution<int> distribution(0, processorCount - 1);
     
     std::vector<int> assignment(jobCount);
@@ -55,4 +56,280 @@ std::vector<int> SolutionGenerator::generateWorstCaseAssignment(int jobCount, in
     std::vector<int> assignment(jobCount, 0); // Все работы на процессор 0
     
     return assignment;
-}
\ No newline at end of file
+}
+
+namespace {
+
+// Число итераций двоичного поиска Multifit: погрешность ёмкости 2^-10 от начального интервала
+constexpr int kMultifitIterations = 10;
+// Ограничение памяти метода разностей: число работ * число процессоров элементов на кортеж
+constexpr size_t kKarmarkarKarpEntries = 1 << 24;
+
+// Дерево максимумов остаточных ёмкостей с поиском самого левого процессора, куда помещается работа
+class CapacityTree {
+public:
+    CapacityTree(int size, double capacity)
+        : leaves_(1) {
+        while (leaves_ < static_cast<size_t>(size)) {
+            leaves_ *= 2;
+        }
+        nodes_.assign(2 * leaves_, std::numeric_limits<double>::lowest());
+        for (int i = 0; i < size; ++i) {
+            nodes_[leaves_ + i] = capacity;
+        }
+        for (size_t i = leaves_ - 1; i >= 1; --i) {
+            nodes_[i] = std::max(nodes_[2 * i], nodes_[2 * i + 1]);
+        }
+    }
+
+    int findFirstFit(double duration) const {
+        if (nodes_[1] < duration) {
+            return -1;
+        }
+        size_t node = 1;
+        while (node < leaves_) {
+            node = nodes_[2 * node] >= duration ? 2 * node : 2 * node + 1;
+        }
+        return static_cast<int>(node - leaves_);
+    }
+
+    void subtract(int index, double duration) {
+        size_t node = leaves_ + index;
+        nodes_[node] -= duration;
+        for (node /= 2; node >= 1; node /= 2) {
+            nodes_[node] = std::max(nodes_[2 * node], nodes_[2 * node + 1]);
+        }
+    }
+
+private:
+    size_t leaves_;
+    std::vector<double> nodes_;
+};
+
+// Подмножество кортежа метода разностей: сумма и односвязный список работ
+struct Subset {
+    double sum;
+    int head;
+    int tail;
+};
+
+}
+
+std::shared_ptr<ScheduleSolution> SolutionGenerator::generateLptSolution(
+    int jobCount, int processorCount, const std::vector<double>& jobDurations) {
+    
+    auto order = sortJobsByDuration(jobCount, jobDurations);
+    std::vector<double> loads(processorCount, 0.0);
+    std::vector<int> assignment(jobCount, 0);
+    assignLongestFirst(processorCount, jobDurations, order, 0, loads, assignment);
+    
+    return buildSolution(jobCount, processorCount, jobDurations, assignment);
+}
+
+std::shared_ptr<ScheduleSolution> SolutionGenerator::generateMultifitSolution(
+    int jobCount, int processorCount, const std::vector<double>& jobDurations) {
+    
+    auto order = sortJobsByDuration(jobCount, jobDurations);
+    double totalDuration = 0.0;
+    for (double duration : jobDurations) {
+        totalDuration += duration;
+    }
+    
+    // Верхняя граница - расписание LPT (не хуже 4/3 оптимума) вместо классической 2 * среднего:
+    // тот же бюджет итераций даёт точность на порядки выше, а результат не хуже LPT
+    std::vector<double> loads(processorCount, 0.0);
+    std::vector<int> assignment(jobCount, 0);
+    assignLongestFirst(processorCount, jobDurations, order, 0, loads, assignment);
+    double lower = std::max(totalDuration / processorCount, jobDurations[order[0]]);
+    double upper = *std::max_element(loads.begin(), loads.end());
+    
+    std::vector<int> candidate(jobCount, 0);
+    for (int iteration = 0; iteration < kMultifitIterations && lower < upper; ++iteration) {
+        double capacity = (lower + upper) / 2;
+        if (generateFirstFitAssignment(processorCount, jobDurations, order, capacity, candidate)) {
+            upper = capacity;
+            assignment.swap(candidate);
+        } else {
+            lower = capacity;
+        }
+    }
+    
+    return buildSolution(jobCount, processorCount, jobDurations, assignment);
+}
+
+std::shared_ptr<ScheduleSolution> SolutionGenerator::generateKarmarkarKarpSolution(
+    int jobCount, int processorCount, const std::vector<double>& jobDurations) {
+    
+    auto order = sortJobsByDuration(jobCount, jobDurations);
+    size_t processors = static_cast<size_t>(processorCount);
+    // Короткие работы сверх лимита памяти почти не влияют на разности: они добавляются жадно после
+    size_t differencingJobs = std::min(order.size(), std::max(processors, kKarmarkarKarpEntries / processors));
+    
+    // Кортежи по processorCount подмножеств, отсортированных по убыванию суммы, лежат подряд в pool
+    std::vector<Subset> pool;
+    std::vector<size_t> freeTuples;
+    std::vector<int> next(jobCount, -1);
+    std::priority_queue<std::pair<double, size_t>> tuples;
+    size_t nextJob = 0;
+    
+    auto allocate = [&]() {
+        if (!freeTuples.empty()) {
+            size_t tuple = freeTuples.back();
+            freeTuples.pop_back();
+            return tuple;
+        }
+        pool.resize(pool.size() + processors);
+        return pool.size() / processors - 1;
+    };
+    
+    // Следующий кортеж с наибольшей разностью: одиночная работа (её разность - длительность) или из кучи
+    auto take = [&]() {
+        if (nextJob < differencingJobs && (tuples.empty() || jobDurations[order[nextJob]] >= tuples.top().first)) {
+            int job = order[nextJob++];
+            size_t tuple = allocate();
+            Subset* subsets = &pool[tuple * processors];
+            subsets[0] = {jobDurations[job], job, job};
+            for (size_t i = 1; i < processors; ++i) {
+                subsets[i] = {0.0, -1, -1};
+            }
+            return tuple;
+        }
+        size_t tuple = tuples.top().second;
+        tuples.pop();
+        return tuple;
+    };
+    
+    std::vector<Subset> combined(processors);
+    while ((differencingJobs - nextJob) + tuples.size() > 1) {
+        size_t first = take();
+        size_t second = take();
+        const Subset* a = &pool[first * processors];
+        const Subset* b = &pool[second * processors];
+        
+        // Самое большое подмножество одного кортежа объединяется с самым маленьким другого
+        for (size_t i = 0; i < processors; ++i) {
+            const Subset& left = a[i];
+            const Subset& right = b[processors - 1 - i];
+            Subset& merged = combined[i];
+            merged.sum = left.sum + right.sum;
+            if (left.head == -1) {
+                merged.head = right.head;
+                merged.tail = right.tail;
+            } else if (right.head == -1) {
+                merged.head = left.head;
+                merged.tail = left.tail;
+            } else {
+                next[left.tail] = right.head;
+                merged.head = left.head;
+                merged.tail = right.tail;
+            }
+        }
+        std::sort(combined.begin(), combined.end(), [](const Subset& x, const Subset& y) { return x.sum > y.sum; });
+        
+        std::copy(combined.begin(), combined.end(), pool.begin() + first * processors);
+        freeTuples.push_back(second);
+        tuples.push({combined.front().sum - combined.back().sum, first});
+    }
+    
+    size_t result = take();
+    std::vector<int> assignment(jobCount, 0);
+    std::vector<double> loads(processorCount, 0.0);
+    for (size_t i = 0; i < processors; ++i) {
+        const Subset& subset = pool[result * processors + i];
+        loads[i] = subset.sum;
+        for (int job = subset.head; job != -1; job = next[job]) {
+            assignment[job] = static_cast<int>(i);
+        }
+    }
+    assignLongestFirst(processorCount, jobDurations, order, differencingJobs, loads, assignment);
+    
+    return buildSolution(jobCount, processorCount, jobDurations, assignment);
+}
+
+std::shared_ptr<ScheduleSolution> SolutionGenerator::generateSolution(
+    const std::string& method, int jobCount, int processorCount, const std::vector<double>& jobDurations,
+    std::uint64_t seed) {
+    
+    validateMethod(method);
+    if (method == "random") {
+        return generateRandomSolution(jobCount, processorCount, jobDurations, seed);
+    } else if (method == "lpt") {
+        return generateLptSolution(jobCount, processorCount, jobDurations);
+    } else if (method == "multifit") {
+        return generateMultifitSolution(jobCount, processorCount, jobDurations);
+    } else if (method == "kk") {
+        return generateKarmarkarKarpSolution(jobCount, processorCount, jobDurations);
+    }
+    return generateWorstCaseSolution(jobCount, processorCount, jobDurations);
+}
+
+void SolutionGenerator::validateMethod(const std::string& method) {
+    if (method != "worst" && method != "random" && method != "lpt" && method != "multifit" && method != "kk") {
+        throw std::invalid_argument("Unknown initial solution: " + method);
+    }
+}
+
+void SolutionGenerator::assignLongestFirst(int processorCount, const std::vector<double>& jobDurations,
+                                           const std::vector<int>& order, size_t firstJob,
+                                           std::vector<double>& loads, std::vector<int>& assignment) {
+    using Entry = std::pair<double, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> leastLoaded;
+    for (int processor = 0; processor < processorCount; ++processor) {
+        leastLoaded.push({loads[processor], processor});
+    }
+    
+    for (size_t i = firstJob; i < order.size(); ++i) {
+        int job = order[i];
+        int processor = leastLoaded.top().second;
+        leastLoaded.pop();
+        assignment[job] = processor;
+        loads[processor] += jobDurations[job];
+        leastLoaded.push({loads[processor], processor});
+    }
+}
+
+bool SolutionGenerator::generateFirstFitAssignment(int processorCount, const std::vector<double>& jobDurations,
+                                                   const std::vector<int>& order, double capacity,
+                                                   std::vector<int>& assignment) {
+    CapacityTree remaining(processorCount, capacity);
+    // Допуск на накопленную ошибку округления сумм
+    double tolerance = capacity * 1e-12;
+    for (int job : order) {
+        int processor = remaining.findFirstFit(jobDurations[job] - tolerance);
+        if (processor == -1) {
+            return false;
+        }
+        remaining.subtract(processor, jobDurations[job]);
+        assignment[job] = processor;
+    }
+    return true;
+}
+
+std::vector<int> SolutionGenerator::sortJobsByDuration(int jobCount, const std::vector<double>& jobDurations) {
+    if (jobCount <= 0 || static_cast<size_t>(jobCount) != jobDurations.size()) {
+        throw std::invalid_argument("Job count must be positive and match job durations");
+    }
+    
+    std::vector<int> order(jobCount);
+    for (int i = 0; i < jobCount; ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&jobDurations](int first, int second) {
+        return jobDurations[first] > jobDurations[second] ||
+               (jobDurations[first] == jobDurations[second] && first < second);
+    });
+    return order;
+}
+
+std::shared_ptr<ScheduleSolution> SolutionGenerator::buildSolution(
+    int jobCount, int processorCount, const std::vector<double>& jobDurations, const std::vector<int>& assignment) {
+    
+    if (processorCount <= 0) {
+        throw std::invalid_argument("Job count and processor count must be positive");
+    }
+    auto solution = std::make_shared<ScheduleSolution>(jobCount, processorCount, jobDurations);
+    for (int i = 0; i < jobCount; ++i) {
+        solution->assignJobToProcessor(i, assignment[i]);
+    }
+    return solution;
+}
@@ -1,18 +1,48 @@
 #pragma once
 
+#include <cstdint>
+#include <string>
 #include <vector>
 #include <memory>
 #include "ScheduleSolution.h"
+#include "RandomGenerator.h"
 
 class SolutionGenerator {
 public:
     static std::shared_ptr<ScheduleSolution> generateRandomSolution(
-        int jobCount, int processorCount, const std::vector<double>& jobDurations);
+        int jobCount, int processorCount, const std::vector<double>& jobDurations,
+        std::uint64_t seed = RandomGenerator::clockSeed());
     
     static std::shared_ptr<ScheduleSolution> generateWorstCaseSolution(
         int jobCount, int processorCount, const std::vector<double>& jobDurations);
     
+    // Конструктивные эвристики P||Cmax: выравнивают загрузки, т.е. главный член фитнеса.
+    // LPT - длинные работы первыми на наименее загруженный процессор (куча по загрузкам)
+    static std::shared_ptr<ScheduleSolution> generateLptSolution(
+        int jobCount, int processorCount, const std::vector<double>& jobDurations);
+    // Multifit - двоичный поиск наименьшей ёмкости, при которой First Fit Decreasing укладывает все работы
+    static std::shared_ptr<ScheduleSolution> generateMultifitSolution(
+        int jobCount, int processorCount, const std::vector<double>& jobDurations);
+    // Метод наибольших разностей (Кармаркар-Карп) для M процессоров
+    static std::shared_ptr<ScheduleSolution> generateKarmarkarKarpSolution(
+        int jobCount, int processorCount, const std::vector<double>& jobDurations);
+    
+    // Начальное решение по имени: worst, random, lpt, multifit, kk
+    static std::shared_ptr<ScheduleSolution> generateSolution(
+        const std::string& method, int jobCount, int processorCount, const std::vector<double>& jobDurations,
+        std::uint64_t seed = RandomGenerator::clockSeed());
+    static void validateMethod(const std::string& method);
+    
 private:
-    static std::vector<int> generateRandomAssignment(int jobCount, int processorCount);
+    static std::vector<int> generateRandomAssignment(int jobCount, int processorCount, std::uint64_t seed);
     static std::vector<int> generateWorstCaseAssignment(int jobCount, int processorCount);
+    // Работы order[firstJob..] по очереди на наименее загруженный процессор; loads обновляются
+    static void assignLongestFirst(int processorCount, const std::vector<double>& jobDurations,
+                                   const std::vector<int>& order, size_t firstJob,
+                                   std::vector<double>& loads, std::vector<int>& assignment);
+    static bool generateFirstFitAssignment(int processorCount, const std::vector<double>& jobDurations,
+                                           const std::vector<int>& order, double capacity, std::vector<int>& assignment);
+    static std::vector<int> sortJobsByDuration(int jobCount, const std::vector<double>& jobDurations);
+    static std::shared_ptr<ScheduleSolution> buildSolution(
+        int jobCount, int processorCount, const std::vector<double>& jobDurations, const std::vector<int>& assignment);
 };
\ No newline at end of file
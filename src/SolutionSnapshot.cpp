@@ -0,0 +1,46 @@
+#include "SolutionSnapshot.h"
+
+SolutionSnapshot::SolutionSnapshot()
+    : version_(0) {
+}
+
+void SolutionSnapshot::publish(const std::shared_ptr<ISolution>& solution, double fitness) {
+    std::atomic_store_explicit(&entry_, std::shared_ptr<const Entry>(std::make_shared<Entry>(Entry{solution, fitness})),
+                               std::memory_order_release);
+    version_.fetch_add(1, std::memory_order_release);
+}
+
+bool SolutionSnapshot::publishIfBetter(const std::shared_ptr<ISolution>& solution, double fitness) {
+    if (!solution) {
+        return false;
+    }
+
+    auto current = std::atomic_load_explicit(&entry_, std::memory_order_acquire);
+    std::shared_ptr<const Entry> next;
+    do {
+        if (current && current->fitness <= fitness) {
+            return false;
+        }
+        if (!next) {
+            next = std::make_shared<Entry>(Entry{solution, fitness});
+        }
+        // При неудаче current обновляется до снимка, опубликованного другим писателем
+    } while (!std::atomic_compare_exchange_weak_explicit(&entry_, &current, next,
+                                                         std::memory_order_acq_rel, std::memory_order_acquire));
+
+    version_.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+std::shared_ptr<const SolutionSnapshot::Entry> SolutionSnapshot::load() const {
+    return std::atomic_load_explicit(&entry_, std::memory_order_acquire);
+}
+
+std::uint64_t SolutionSnapshot::version() const {
+    return version_.load(std::memory_order_acquire);
+}
+
+void SolutionSnapshot::reset() {
+    std::atomic_store_explicit(&entry_, std::shared_ptr<const Entry>(), std::memory_order_release);
+    version_.fetch_add(1, std::memory_order_release);
+}
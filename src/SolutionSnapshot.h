@@ -0,0 +1,32 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include "ISolution.h"
+
+// Слот для обмена лучшим решением между потоками без блокировок: писатель публикует
+// неизменяемый снимок атомарной заменой указателя, читатель по номеру версии
+// узнаёт о новом снимке и никогда не ждёт писателя.
+// Опубликованное решение не должно изменяться - читатели получают тот же объект
+class SolutionSnapshot {
+public:
+    struct Entry {
+        std::shared_ptr<ISolution> solution;
+        double fitness;
+    };
+
+    SolutionSnapshot();
+    SolutionSnapshot(const SolutionSnapshot&) = delete;
+    SolutionSnapshot& operator=(const SolutionSnapshot&) = delete;
+
+    void publish(const std::shared_ptr<ISolution>& solution, double fitness);
+    bool publishIfBetter(const std::shared_ptr<ISolution>& solution, double fitness);
+    std::shared_ptr<const Entry> load() const;
+    std::uint64_t version() const;
+    void reset();
+
+private:
+    std::shared_ptr<const Entry> entry_;
+    std::atomic<std::uint64_t> version_;
+};
@@ -0,0 +1,80 @@
+#include "SumTree.h"
+#include <stdexcept>
+
+SumTree::SumTree()
+    : size_(0)
+    , capacity_(1)
+    , nodes_(2, 0.0) {
+}
+
+SumTree::SumTree(int size)
+    : size_(size)
+    , capacity_(1) {
+    if (size_ < 0) {
+        throw std::invalid_argument("Tree size must be non-negative");
+    }
+    // Полное двоичное дерево: спуск от корня к листу без проверок границ
+    while (capacity_ < size_) {
+        capacity_ *= 2;
+    }
+    nodes_.assign(2 * static_cast<size_t>(capacity_), 0.0);
+}
+
+void SumTree::set(int index, double weight) {
+    if (index < 0 || index >= size_) {
+        throw std::out_of_range("Tree index out of range");
+    }
+    if (!(weight >= 0.0)) {
+        throw std::invalid_argument("Weights must be non-negative");
+    }
+
+    int position = index + capacity_;
+    nodes_[position] = weight;
+    // Узлы пересчитываются из детей, а не сдвигаются на разность: ошибка округления не накапливается
+    for (position /= 2; position >= 1; position /= 2) {
+        nodes_[position] = nodes_[2 * position] + nodes_[2 * position + 1];
+    }
+}
+
+void SumTree::assign(const std::vector<double>& weights) {
+    if (static_cast<int>(weights.size()) != size_) {
+        throw std::invalid_argument("Weight count does not match tree size");
+    }
+    for (int i = 0; i < size_; ++i) {
+        if (!(weights[i] >= 0.0)) {
+            throw std::invalid_argument("Weights must be non-negative");
+        }
+        nodes_[capacity_ + i] = weights[i];
+    }
+    for (int position = capacity_ - 1; position >= 1; --position) {
+        nodes_[position] = nodes_[2 * position] + nodes_[2 * position + 1];
+    }
+}
+
+double SumTree::total() const {
+    return nodes_[1];
+}
+
+int SumTree::find(double target) const {
+    if (!(total() > 0.0)) {
+        throw std::logic_error("Cannot sample from a tree with zero total weight");
+    }
+
+    int position = 1;
+    while (position < capacity_) {
+        int left = 2 * position;
+        // Из-за округления target может оказаться не меньше суммы узла; тогда спуск
+        // не должен уйти в правое поддерево нулевого веса
+        if (target < nodes_[left] || nodes_[left + 1] <= 0.0) {
+            position = left;
+        } else {
+            target -= nodes_[left];
+            position = left + 1;
+        }
+    }
+    return position - capacity_;
+}
+
+int SumTree::size() const {
+    return size_;
+}
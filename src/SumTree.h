@@ -0,0 +1,24 @@
+#pragma once
+
+#include <vector>
+
+// Дерево сумм неотрицательных весов: выбор элемента с вероятностью,
+// пропорциональной его весу, и обновление веса за O(log n)
+class SumTree {
+public:
+    SumTree();
+    explicit SumTree(int size);
+
+    void set(int index, double weight);
+    // Перестройка по всем весам сразу за O(n)
+    void assign(const std::vector<double>& weights);
+    double total() const;
+    // Элемент, в отрезок накопленной суммы которого попадает target из [0, total())
+    int find(double target) const;
+    int size() const;
+
+private:
+    int size_;
+    int capacity_;
+    std::vector<double> nodes_;
+};
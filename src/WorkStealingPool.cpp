@@ -0,0 +1,146 @@
+#include "WorkStealingPool.h"
+#include <stdexcept>
+
+namespace {
+
+// Пул и номер потока, выполняющего текущую задачу: по ним submit() выбирает свою деку
+thread_local const WorkStealingPool* currentPool = nullptr;
+thread_local int currentWorker = -1;
+
+}
+
+WorkStealingPool::WorkStealingPool(int threadCount)
+    : queuedTasks_(0)
+    , pendingTasks_(0)
+    , stopping_(false)
+    , nextQueue_(0)
+    , stealCount_(0) {
+    if (threadCount <= 0) {
+        threadCount = std::thread::hardware_concurrency();
+        if (threadCount == 0) threadCount = 1;
+    }
+
+    for (int i = 0; i < threadCount; ++i) {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (int i = 0; i < threadCount; ++i) {
+        threads_.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        stopping_ = true;
+    }
+    workAvailable_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+void WorkStealingPool::submit(Task task) {
+    int queueIndex = currentPool == this
+        ? currentWorker
+        : static_cast<int>(nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size());
+
+    {
+        // Счётчики меняются под stateMutex_, чтобы засыпающий поток не пропустил уведомление, и до
+        // публикации задачи: иначе вор успеет выполнить её и уменьшить pendingTasks_ раньше увеличения
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        ++pendingTasks_;
+        queuedTasks_.fetch_add(1, std::memory_order_relaxed);
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues_[queueIndex]->mutex);
+        queues_[queueIndex]->tasks.push_back(std::move(task));
+    }
+    workAvailable_.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    allDone_.wait(lock, [this] { return pendingTasks_ == 0; });
+
+    if (firstError_) {
+        std::exception_ptr error = firstError_;
+        firstError_ = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+int WorkStealingPool::threadCount() const {
+    return static_cast<int>(threads_.size());
+}
+
+std::uint64_t WorkStealingPool::stealCount() const {
+    return stealCount_.load(std::memory_order_relaxed);
+}
+
+void WorkStealingPool::workerLoop(int workerIndex) {
+    currentPool = this;
+    currentWorker = workerIndex;
+
+    Task task;
+    while (true) {
+        if (takeTask(workerIndex, task)) {
+            try {
+                task();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(stateMutex_);
+                if (!firstError_) {
+                    firstError_ = std::current_exception();
+                }
+            }
+            task = nullptr;
+            finishTask();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(stateMutex_);
+        workAvailable_.wait(lock, [this] {
+            return stopping_ || queuedTasks_.load(std::memory_order_relaxed) > 0;
+        });
+        if (stopping_ && queuedTasks_.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+    }
+}
+
+bool WorkStealingPool::takeTask(int workerIndex, Task& task) {
+    {
+        WorkerQueue& own = *queues_[workerIndex];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            queuedTasks_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    int queueCount = static_cast<int>(queues_.size());
+    for (int offset = 1; offset < queueCount; ++offset) {
+        WorkerQueue& victim = *queues_[(workerIndex + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queuedTasks_.fetch_sub(1, std::memory_order_relaxed);
+            stealCount_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::finishTask() {
+    bool allDone;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        allDone = --pendingTasks_ == 0;
+    }
+    if (allDone) {
+        allDone_.notify_all();
+    }
+}
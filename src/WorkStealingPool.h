@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Пул потоков с перехватом работы: у каждого потока своя дека задач. Поток берёт задачи
+// с конца своей деки (последние добавленные, данные ещё в кэше), а простаивающий поток
+// забирает задачи с начала чужих дек. Задачи, поставленные из задачи пула, попадают
+// в деку текущего потока, поставленные извне - распределяются по кругу
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit WorkStealingPool(int threadCount);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    void submit(Task task);
+    // Ждёт завершения всех задач; первое исключение из задач пробрасывается вызывающему
+    void wait();
+
+    int threadCount() const;
+    std::uint64_t stealCount() const;
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> threads_;
+
+    std::mutex stateMutex_;
+    std::condition_variable workAvailable_;
+    std::condition_variable allDone_;
+    std::atomic<size_t> queuedTasks_;
+    size_t pendingTasks_;
+    bool stopping_;
+    std::exception_ptr firstError_;
+
+    std::atomic<unsigned> nextQueue_;
+    std::atomic<std::uint64_t> stealCount_;
+
+    void workerLoop(int workerIndex);
+    bool takeTask(int workerIndex, Task& task);
+    void finishTask();
+};
@@ -1,37 +1,373 @@
+#include <atomic>
+#include <csignal>
 #include <iostream>
+#include <fstream>
 #include <memory>
 #include <chrono>
+#include <sstream>
 #include <string>
+#include <vector>
+#include "BatchSolver.h"
+#include "BinaryDataWriter.h"
+#include "ExperimentRunner.h"
 #include "ParallelSimulatedAnnealing.h"
+#include "ParallelTempering.h"
 #include "ScheduleSolution.h"
 #include "ScheduleMutation.h"
 #include "SolutionGenerator.h"
 #include "BoltzmannCooling.h"
 #include "CauchyCooling.h"
+#include "ConstantCooling.h"
 #include "LogarithmicCooling.h"
+#include "GeometricCooling.h"
+#include "HuangCooling.h"
+#include "LamDelosmeCooling.h"
 #include "CSVDataGenerator.h"
-#include "CSVDataReader.h"
 #include "Logger.h"
+#include "RandomGenerator.h"
 
 void printUsage(const std::string& programName) {
-    std::cout << "Usage: " << programName << " <job_count>  <processor_count> <min_duration> <max_duration> <exchange_interval> <initial_temperature> <cooling_law> <iterations_per_temperature> <iterations_without_improvement> <iterations_without_improvement_global> <num_threads> <log>(optional)" << std::endl;
-    std::cout << "Example: " << programName << " 10 2 1.0 15.0 100 1000.0 boltzmann 50 1000 10 4 log" << std::endl;
-    std::cout << "Cooling laws: boltzmann, cauchy, logarithmic" << std::endl;
+    std::cout << "Usage: " << programName << " <job_count>  <processor_count> <min_duration> <max_duration> <exchange_interval> <initial_temperature> <cooling_law> <iterations_per_temperature> <iterations_without_improvement> <iterations_without_improvement_global> <num_threads> [log] [--log-level trace|debug|info] [--seed <value>] [--elite <size>] [--elite-distance <jobs>] [--metrics <file>] [--metrics-samples <file>] [--metrics-interval <ms>] [--epoch <iterations>] [--async-exchange] [--engine psa|tempering] [--t-min <temperature>] [--swap-rate <rate>] [--fixed-ladder] [--islands ring|torus|random-k|full] [--migration best-worst|probabilistic|elite] [--island-degree <k>] [--migration-interval <epochs>] [--input <instance.csv|instance.bin>] [--distribution <family>] [--initial worst|random|lpt|multifit|kk] [--batch <candidates>] [--batch-selection first|best] [--rejection-free <sample_size>] [--rejection-free-threshold <rate>] [--stagnation stop|reheat|elite|kick] [--max-restarts <count>] [--reheat-fraction <fraction>] [--kick-moves <moves>] [--time-limit <ms>] [--target <fitness>] [--progress]" << std::endl;
+    std::cout << "Example: " << programName << " 10 2 1.0 15.0 100 1000.0 boltzmann 50 1000 10 4 log --seed 42" << std::endl;
+    std::cout << "Batch: " << programName << " batch <instances_dir_or_manifest> <output_csv> <initial_temperature> <cooling_law> <iterations_per_temperature> <iterations_without_improvement> <num_threads> <restarts> [log] [--log-level trace|debug|info] [--seed <value>]" << std::endl;
+    std::cout << "Convert: " << programName << " convert <input.csv> <output.bin>" << std::endl;
+    std::cout << "Generate: " << programName << " generate <job_count> <processor_count> <min_duration> <max_duration> <output.csv|output.bin> [--distribution <family>] [--seed <value>] [--threads <count>]" << std::endl;
+    std::cout << "Experiment: " << programName << " experiment (--instances <dir_or_manifest> | --jobs <n1,n2,...> --processors <m1,m2,...> [--min-duration <value>] [--max-duration <value>] [--distribution <family>]) [--threads <t1,t2,...>] [--cooling <law1,law2,...>] [--t0 <T1,T2,...>] [--iterations-per-temp <i1,i2,...>] [--exchange-interval <e1,e2,...>] [--no-improve <n>] [--no-improve-global <n>] [--initial <method>] [--trials <n>] [--seed <value>] [--output <prefix>] [log]" << std::endl;
+    std::cout << "Cooling laws: boltzmann, cauchy, logarithmic, constant, geometric[:alpha], lam[:planned_steps], huang[:lambda]" << std::endl;
+    std::cout << "Distributions: uniform, normal, exponential, pareto, bimodal, hard" << std::endl;
 }
 
-std::shared_ptr<ICoolingLaw> createCoolingLaw(const std::string& lawName) {
+// Флаг прерывания по SIGINT/SIGTERM: алгоритм опрашивает его и возвращает лучшее найденное решение.
+// Повторный сигнал обрабатывается по умолчанию и завершает процесс сразу
+std::atomic<bool> interruptRequested(false);
+
+extern "C" void handleInterrupt(int signal) {
+    interruptRequested.store(true);
+    std::signal(signal, SIG_DFL);
+}
+
+LogLevel parseLogLevel(const std::string& levelName) {
+    if (levelName == "trace") {
+        return LogLevel::Trace;
+    } else if (levelName == "debug") {
+        return LogLevel::Debug;
+    } else if (levelName == "info") {
+        return LogLevel::Info;
+    } else {
+        throw std::invalid_argument("Unknown log level: " + levelName);
+    }
+}
+
+// Имя закона с необязательным параметром адаптивных законов: "geometric:0.9", "lam:300", "huang:0.5"
+std::shared_ptr<ICoolingLaw> createCoolingLaw(const std::string& lawSpec) {
+    size_t separator = lawSpec.find(':');
+    std::string lawName = lawSpec.substr(0, separator);
+    std::string parameter = separator == std::string::npos ? "" : lawSpec.substr(separator + 1);
+    if (!parameter.empty() && lawName != "geometric" && lawName != "lam" && lawName != "huang") {
+        throw std::invalid_argument("Cooling law takes no parameter: " + lawSpec);
+    }
+    
     if (lawName == "boltzmann") {
         return std::make_shared<BoltzmannCooling>();
     } else if (lawName == "cauchy") {
         return std::make_shared<CauchyCooling>();
     } else if (lawName == "logarithmic") {
         return std::make_shared<LogarithmicCooling>();
+    } else if (lawName == "constant") {
+        return std::make_shared<ConstantCooling>();
+    } else if (lawName == "geometric") {
+        return parameter.empty() ? std::make_shared<GeometricCooling>() : std::make_shared<GeometricCooling>(std::stod(parameter));
+    } else if (lawName == "lam") {
+        return parameter.empty() ? std::make_shared<LamDelosmeCooling>() : std::make_shared<LamDelosmeCooling>(std::stoi(parameter));
+    } else if (lawName == "huang") {
+        return parameter.empty() ? std::make_shared<HuangCooling>() : std::make_shared<HuangCooling>(std::stod(parameter));
     } else {
-        throw std::invalid_argument("Unknown cooling law: " + lawName);
+        throw std::invalid_argument("Unknown cooling law: " + lawSpec);
+    }
+}
+
+template <typename Value>
+std::vector<Value> parseList(const std::string& text, Value (*parse)(const std::string&)) {
+    std::vector<Value> values;
+    std::stringstream stream(text);
+    std::string token;
+    while (std::getline(stream, token, ',')) {
+        values.push_back(parse(token));
+    }
+    if (values.empty()) {
+        throw std::invalid_argument("Empty list: " + text);
+    }
+    return values;
+}
+
+int parseInt(const std::string& text) {
+    return std::stoi(text);
+}
+
+double parseDouble(const std::string& text) {
+    return std::stod(text);
+}
+
+std::string parseString(const std::string& text) {
+    return text;
+}
+
+int runBatch(int argc, char* argv[]) {
+    if (argc < 10) {
+        std::cerr << "Error: Invalid number of arguments" << std::endl;
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    try {
+        std::string instancesPath = argv[2];
+        std::string outputPath = argv[3];
+        double initialTemperature = std::stod(argv[4]);
+        std::string coolingLawName = argv[5];
+        int iterationsPerTemperature = std::stoi(argv[6]);
+        int iterationsWithoutImprovement = std::stoi(argv[7]);
+        int numThreads = std::stoi(argv[8]);
+        int restarts = std::stoi(argv[9]);
+        bool enableLogging = false;
+        LogLevel logLevel = LogLevel::Trace;
+        std::uint64_t seed = RandomGenerator::clockSeed();
+        for (int i = 10; i < argc; ++i) {
+            std::string option = argv[i];
+            if (option == "log") {
+                enableLogging = true;
+            } else if (option == "--log-level" && i + 1 < argc) {
+                logLevel = parseLogLevel(argv[++i]);
+            } else if (option == "--seed" && i + 1 < argc) {
+                seed = std::stoull(argv[++i]);
+            } else {
+                throw std::invalid_argument("Unknown option: " + option);
+            }
+        }
+        Logger::initialize(enableLogging, "simulated_annealing.log", logLevel);
+
+        if (initialTemperature <= 0 || numThreads <= 0 || restarts <= 0) {
+            throw std::invalid_argument("All numeric parameters must be positive");
+        }
+        createCoolingLaw(coolingLawName);
+
+        std::cout << "=== Batch Simulated Annealing Scheduler ===" << std::endl;
+        std::cout << "Seed: " << seed << std::endl;
+
+        auto instances = BatchSolver::collectInstances(instancesPath);
+        std::cout << "Instances: " << instances.size() << std::endl;
+
+        BatchSolver solver(numThreads);
+        solver.setCoolingLawFactory([coolingLawName]() { return createCoolingLaw(coolingLawName); });
+        solver.setInitialTemperature(initialTemperature);
+        solver.setIterationsPerTemperature(iterationsPerTemperature);
+        solver.setMaxIterationsWithoutImprovement(iterationsWithoutImprovement);
+        solver.setRestarts(restarts);
+        solver.setSeed(seed);
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        int solved = solver.solve(instances, outputPath);
+        auto endTime = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+
+        std::cout << "Solved " << solved << " of " << instances.size() << " instances in "
+                  << duration.count() << " ms, results written to " << outputPath << std::endl;
+        Logger::shutdown();
+        return solved == static_cast<int>(instances.size()) ? 0 : 2;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        printUsage(argv[0]);
+        return 1;
+    }
+}
+
+int runConvert(int argc, char* argv[]) {
+    if (argc != 4) {
+        std::cerr << "Error: Invalid number of arguments" << std::endl;
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    try {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        InputData data = IDataReader::createForPath(argv[2])->readData(argv[2]);
+        BinaryDataWriter::writeData(data, argv[3]);
+        auto endTime = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+
+        std::cout << "Converted " << data.jobCount << " jobs to " << argv[3] << " in " << duration.count() << " ms" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+int runGenerate(int argc, char* argv[]) {
+    if (argc < 7) {
+        std::cerr << "Error: Invalid number of arguments" << std::endl;
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    try {
+        int jobCount = std::stoi(argv[2]);
+        int processorCount = std::stoi(argv[3]);
+        double minDuration = std::stod(argv[4]);
+        double maxDuration = std::stod(argv[5]);
+        std::string outputPath = argv[6];
+        auto distribution = InstanceGenerator::Distribution::Uniform;
+        std::uint64_t seed = RandomGenerator::clockSeed();
+        int threadCount = 0;
+        for (int i = 7; i < argc; ++i) {
+            std::string option = argv[i];
+            if (option == "--distribution" && i + 1 < argc) {
+                distribution = InstanceGenerator::parseDistribution(argv[++i]);
+            } else if (option == "--seed" && i + 1 < argc) {
+                seed = std::stoull(argv[++i]);
+            } else if (option == "--threads" && i + 1 < argc) {
+                threadCount = std::stoi(argv[++i]);
+            } else {
+                throw std::invalid_argument("Unknown option: " + option);
+            }
+        }
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        auto dataGenerator = IDataGenerator::createForPath(outputPath);
+        dataGenerator->setSeed(seed);
+        dataGenerator->setDistribution(distribution);
+        if (threadCount > 0) {
+            dataGenerator->setThreadCount(threadCount);
+        }
+        dataGenerator->generateData(jobCount, processorCount, minDuration, maxDuration, outputPath);
+        auto endTime = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+
+        std::cout << "Generated " << jobCount << " jobs to " << outputPath << " in " << duration.count()
+                  << " ms, seed " << seed << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+int runExperiment(int argc, char* argv[]) {
+    try {
+        ExperimentRunner::Grid grid;
+        std::string instancesPath;
+        std::vector<int> jobCounts;
+        std::vector<int> processorCounts;
+        double minDuration = 1.0;
+        double maxDuration = 15.0;
+        auto distribution = InstanceGenerator::Distribution::Uniform;
+        std::uint64_t seed = RandomGenerator::clockSeed();
+        std::string outputPrefix = "experiment";
+        bool enableLogging = false;
+        for (int i = 2; i < argc; ++i) {
+            std::string option = argv[i];
+            if (option == "log") {
+                enableLogging = true;
+            } else if (option == "--instances" && i + 1 < argc) {
+                instancesPath = argv[++i];
+            } else if (option == "--jobs" && i + 1 < argc) {
+                jobCounts = parseList(argv[++i], parseInt);
+            } else if (option == "--processors" && i + 1 < argc) {
+                processorCounts = parseList(argv[++i], parseInt);
+            } else if (option == "--min-duration" && i + 1 < argc) {
+                minDuration = std::stod(argv[++i]);
+            } else if (option == "--max-duration" && i + 1 < argc) {
+                maxDuration = std::stod(argv[++i]);
+            } else if (option == "--distribution" && i + 1 < argc) {
+                distribution = InstanceGenerator::parseDistribution(argv[++i]);
+            } else if (option == "--threads" && i + 1 < argc) {
+                grid.threadCounts = parseList(argv[++i], parseInt);
+            } else if (option == "--cooling" && i + 1 < argc) {
+                grid.coolingLaws = parseList(argv[++i], parseString);
+            } else if (option == "--t0" && i + 1 < argc) {
+                grid.initialTemperatures = parseList(argv[++i], parseDouble);
+            } else if (option == "--iterations-per-temp" && i + 1 < argc) {
+                grid.iterationsPerTemperature = parseList(argv[++i], parseInt);
+            } else if (option == "--exchange-interval" && i + 1 < argc) {
+                grid.exchangeIntervals = parseList(argv[++i], parseInt);
+            } else if (option == "--no-improve" && i + 1 < argc) {
+                grid.maxIterationsWithoutImprovement = std::stoi(argv[++i]);
+            } else if (option == "--no-improve-global" && i + 1 < argc) {
+                grid.maxIterationsWithoutImprovementGlobal = std::stoi(argv[++i]);
+            } else if (option == "--initial" && i + 1 < argc) {
+                grid.initialSolution = argv[++i];
+            } else if (option == "--trials" && i + 1 < argc) {
+                grid.trials = std::stoi(argv[++i]);
+            } else if (option == "--seed" && i + 1 < argc) {
+                seed = std::stoull(argv[++i]);
+            } else if (option == "--output" && i + 1 < argc) {
+                outputPrefix = argv[++i];
+            } else {
+                throw std::invalid_argument("Unknown option: " + option);
+            }
+        }
+        Logger::initialize(enableLogging, "simulated_annealing.log", LogLevel::Info);
+
+        if (instancesPath.empty() == (jobCounts.empty() || processorCounts.empty())) {
+            throw std::invalid_argument("Specify either --instances or both --jobs and --processors");
+        }
+
+        ExperimentRunner runner(grid, createCoolingLaw);
+        runner.setSeed(seed);
+
+        std::cout << "=== Simulated Annealing Experiment ===" << std::endl;
+        std::cout << "Seed: " << seed << std::endl;
+
+        if (!instancesPath.empty()) {
+            for (const auto& path : BatchSolver::collectInstances(instancesPath)) {
+                runner.addInstance(path, IDataReader::createForPath(path)->readData(path));
+            }
+        } else {
+            // Сгенерированные задачи не пишутся на диск; зерно зависит только от размеров
+            InstanceGenerator generator;
+            generator.setDistribution(distribution);
+            for (int jobCount : jobCounts) {
+                for (int processorCount : processorCounts) {
+                    generator.setSeed(RandomGenerator::deriveSeed(RandomGenerator::deriveSeed(seed, jobCount), processorCount));
+                    runner.addInstance(std::to_string(jobCount) + "x" + std::to_string(processorCount),
+                                       generator.generateData(jobCount, processorCount, minDuration, maxDuration));
+                }
+            }
+        }
+
+        runner.run();
+        runner.writeTrialsCsv(outputPrefix + "_trials.csv");
+        runner.writeSummaryCsv(outputPrefix + "_summary.csv");
+        runner.writeSummaryJson(outputPrefix + "_summary.json");
+
+        std::cout << "Results written to " << outputPrefix << "_trials.csv, " << outputPrefix << "_summary.csv, "
+                  << outputPrefix << "_summary.json" << std::endl;
+        Logger::shutdown();
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        printUsage(argv[0]);
+        return 1;
     }
 }
 
 int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "batch") {
+        return runBatch(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "convert") {
+        return runConvert(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "generate") {
+        return runGenerate(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "experiment") {
+        return runExperiment(argc, argv);
+    }
+
     if (argc < 12) {
         std::cerr << "Error: Invalid number of arguments" << std::endl;
         printUsage(argv[0]);
@@ -50,18 +386,139 @@ int main(int argc, char* argv[]) {
         int iterationsWithoutImprovement = std::stoi(argv[9]);
         int iterationsWithoutImprovementGlobal = std::stoi(argv[10]);
         int numThreads = std::stoi(argv[11]);
-        bool enableLogging = (argc > 12) && (argv[12] == std::string("log"));
-        Logger::initialize(enableLogging, "simulated_annealing.log");
+        bool enableLogging = false;
+        LogLevel logLevel = LogLevel::Trace;
+        std::uint64_t seed = RandomGenerator::clockSeed();
+        int eliteSize = 0;
+        int eliteDistance = 1;
+        std::string metricsPath;
+        std::string metricsSamplesPath;
+        int metricsInterval = 1000;
+        long long epochIterations = 10000;
+        bool asyncExchange = false;
+        std::string engine = "psa";
+        double minTemperature = 0.0;
+        double swapRate = 0.23;
+        bool adaptiveLadder = true;
+        std::string islandTopology;
+        std::string migrationPolicy = "best-worst";
+        int islandDegree = 2;
+        int migrationInterval = 1;
+        std::string inputPath;
+        auto distribution = InstanceGenerator::Distribution::Uniform;
+        std::string initialMethod = "worst";
+        int batchSize = 1;
+        auto batchSelection = SimulatedAnnealing::BatchSelection::FirstAccepted;
+        int rejectionFreeSample = 0;
+        double rejectionFreeThreshold = 0.01;
+        auto stagnationStrategy = SimulatedAnnealing::StagnationStrategy::Stop;
+        int maxRestarts = 10;
+        double reheatFraction = 0.5;
+        int kickMoves = 10;
+        double timeLimitMilliseconds = 0.0;
+        bool hasTarget = false;
+        double targetFitness = 0.0;
+        bool reportProgress = false;
+        for (int i = 12; i < argc; ++i) {
+            std::string option = argv[i];
+            if (option == "log") {
+                enableLogging = true;
+            } else if (option == "--log-level" && i + 1 < argc) {
+                logLevel = parseLogLevel(argv[++i]);
+            } else if (option == "--seed" && i + 1 < argc) {
+                seed = std::stoull(argv[++i]);
+            } else if (option == "--elite" && i + 1 < argc) {
+                eliteSize = std::stoi(argv[++i]);
+            } else if (option == "--elite-distance" && i + 1 < argc) {
+                eliteDistance = std::stoi(argv[++i]);
+            } else if (option == "--metrics" && i + 1 < argc) {
+                metricsPath = argv[++i];
+            } else if (option == "--metrics-samples" && i + 1 < argc) {
+                metricsSamplesPath = argv[++i];
+            } else if (option == "--metrics-interval" && i + 1 < argc) {
+                metricsInterval = std::stoi(argv[++i]);
+            } else if (option == "--epoch" && i + 1 < argc) {
+                epochIterations = std::stoll(argv[++i]);
+            } else if (option == "--async-exchange") {
+                asyncExchange = true;
+            } else if (option == "--engine" && i + 1 < argc) {
+                engine = argv[++i];
+            } else if (option == "--t-min" && i + 1 < argc) {
+                minTemperature = std::stod(argv[++i]);
+            } else if (option == "--swap-rate" && i + 1 < argc) {
+                swapRate = std::stod(argv[++i]);
+            } else if (option == "--fixed-ladder") {
+                adaptiveLadder = false;
+            } else if (option == "--islands" && i + 1 < argc) {
+                islandTopology = argv[++i];
+            } else if (option == "--migration" && i + 1 < argc) {
+                migrationPolicy = argv[++i];
+            } else if (option == "--island-degree" && i + 1 < argc) {
+                islandDegree = std::stoi(argv[++i]);
+            } else if (option == "--migration-interval" && i + 1 < argc) {
+                migrationInterval = std::stoi(argv[++i]);
+            } else if (option == "--input" && i + 1 < argc) {
+                inputPath = argv[++i];
+            } else if (option == "--distribution" && i + 1 < argc) {
+                distribution = InstanceGenerator::parseDistribution(argv[++i]);
+            } else if (option == "--initial" && i + 1 < argc) {
+                initialMethod = argv[++i];
+            } else if (option == "--batch" && i + 1 < argc) {
+                batchSize = std::stoi(argv[++i]);
+            } else if (option == "--batch-selection" && i + 1 < argc) {
+                batchSelection = SimulatedAnnealing::parseBatchSelection(argv[++i]);
+            } else if (option == "--rejection-free" && i + 1 < argc) {
+                rejectionFreeSample = std::stoi(argv[++i]);
+            } else if (option == "--rejection-free-threshold" && i + 1 < argc) {
+                rejectionFreeThreshold = std::stod(argv[++i]);
+            } else if (option == "--stagnation" && i + 1 < argc) {
+                stagnationStrategy = SimulatedAnnealing::parseStagnationStrategy(argv[++i]);
+            } else if (option == "--max-restarts" && i + 1 < argc) {
+                maxRestarts = std::stoi(argv[++i]);
+            } else if (option == "--reheat-fraction" && i + 1 < argc) {
+                reheatFraction = std::stod(argv[++i]);
+            } else if (option == "--kick-moves" && i + 1 < argc) {
+                kickMoves = std::stoi(argv[++i]);
+            } else if (option == "--time-limit" && i + 1 < argc) {
+                timeLimitMilliseconds = std::stod(argv[++i]);
+            } else if (option == "--target" && i + 1 < argc) {
+                hasTarget = true;
+                targetFitness = std::stod(argv[++i]);
+            } else if (option == "--progress") {
+                reportProgress = true;
+            } else {
+                throw std::invalid_argument("Unknown option: " + option);
+            }
+        }
+        Logger::initialize(enableLogging, "simulated_annealing.log", logLevel);
+        SolutionGenerator::validateMethod(initialMethod);
 
-        if (jobCount <= 0 || processorCount <= 0 || numThreads <= 0 || exchangeInterval <= 0) {
+        // Размеры задачи из аргументов нужны только для генерации, с --input они игнорируются
+        if (numThreads <= 0 || exchangeInterval <= 0 || (inputPath.empty() && (jobCount <= 0 || processorCount <= 0))) {
             throw std::invalid_argument("All numeric parameters must be positive");
         }
-        if (jobMinDuration <= 0 || jobMaxDuration <= jobMinDuration) {
+        if (inputPath.empty() && (jobMinDuration <= 0 || jobMaxDuration <= jobMinDuration)) {
             throw std::invalid_argument("Invalid duration range");
         }
         if (initialTemperature <= 0) {
             throw std::invalid_argument("Initial temperature must be positive");
         }
+        if (engine != "psa" && engine != "tempering") {
+            throw std::invalid_argument("Unknown engine: " + engine);
+        }
+        if (engine == "tempering" && (eliteSize > 0 || asyncExchange || !metricsSamplesPath.empty() || !islandTopology.empty() ||
+                                      batchSize != 1 || rejectionFreeSample > 0 ||
+                                      stagnationStrategy != SimulatedAnnealing::StagnationStrategy::Stop ||
+                                      timeLimitMilliseconds > 0 || hasTarget || reportProgress)) {
+            throw std::invalid_argument("--elite, --async-exchange, --islands, --metrics-samples, --batch, --rejection-free, "
+                                        "--stagnation, --time-limit, --target and --progress require the psa engine");
+        }
+        if (batchSize <= 0) {
+            throw std::invalid_argument("Batch size must be positive");
+        }
+        if (asyncExchange && !islandTopology.empty()) {
+            throw std::invalid_argument("--async-exchange cannot be combined with --islands");
+        }
 
         auto coolingLaw = createCoolingLaw(coolingLawName);
 
@@ -71,48 +528,134 @@ int main(int argc, char* argv[]) {
             std::cout << argv[i] << " ";
         }
         std::cout << std::endl;
+        std::cout << "Seed: " << seed << std::endl;
         
-        CSVDataGenerator dataGenerator;
-        dataGenerator.generateData(jobCount, processorCount, jobMinDuration, jobMaxDuration, "input.csv");
+        // Без --input задача генерируется заново в input.csv, размеры берутся из аргументов
+        if (inputPath.empty()) {
+            inputPath = "input.csv";
+            CSVDataGenerator dataGenerator;
+            dataGenerator.setSeed(RandomGenerator::deriveSeed(seed, 0));
+            dataGenerator.setDistribution(distribution);
+            dataGenerator.generateData(jobCount, processorCount, jobMinDuration, jobMaxDuration, inputPath);
+        }
         
-        CSVDataReader reader;
-        InputData data = reader.readData("input.csv");
+        auto loadStart = std::chrono::high_resolution_clock::now();
+        InputData data = IDataReader::createForPath(inputPath)->readData(inputPath);
+        auto loadEnd = std::chrono::high_resolution_clock::now();
+        std::cout << "Loaded " << data.jobCount << " jobs, " << data.processorCount << " processors from " << inputPath
+                  << " in " << std::chrono::duration_cast<std::chrono::milliseconds>(loadEnd - loadStart).count() << " ms" << std::endl;
         
-        std::cout << "\n1. Creating initial solution..." << std::endl;
-        SolutionGenerator generator;
-        auto initialSolution = generator.generateWorstCaseSolution(data.jobCount, data.processorCount, data.jobDurations);
-        double initialFitness = initialSolution->evaluate();
-        std::cout << "Initial solution fitness: " << initialFitness << std::endl;
+        std::cout << "\n1. Creating initial solution (" << initialMethod << ")..." << std::endl;
+        auto constructionStart = std::chrono::high_resolution_clock::now();
+        auto initialSolution = SolutionGenerator::generateSolution(initialMethod, data.jobCount, data.processorCount,
+                                                                   data.jobDurations, RandomGenerator::deriveSeed(seed, 2));
+        auto constructionEnd = std::chrono::high_resolution_clock::now();
+        double initialFitness = initialSolution->fitness();
+        std::cout << "Initial solution fitness: " << initialFitness << " (built in "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(constructionEnd - constructionStart).count()
+                  << " ms)" << std::endl;
         
-        std::cout << "\n2. Configuring parallel simulated annealing..." << std::endl;
         auto mutation = std::make_shared<ScheduleMutation>();
-        coolingLaw->initialize(initialTemperature);
+        std::shared_ptr<ISolution> bestSolution;
+        ParallelMetrics metrics;
+        std::chrono::milliseconds duration;
         
-        ParallelSimulatedAnnealing psa(numThreads);
-        psa.setInitialSolution(initialSolution);
-        psa.setMutation(mutation);
-        psa.setCoolingLaw(coolingLaw);
-        psa.setInitialTemperature(initialTemperature);
-        psa.setIterationsPerTemperature(iterationsPerTemperature);
-        psa.setMaxIterationsWithoutImprovement(iterationsWithoutImprovement);
-        psa.setMaxIterationsWithoutImprovementGlobal(iterationsWithoutImprovementGlobal);
-        psa.setExchangeInterval(exchangeInterval);
-        
-        std::cout << "\n3. Running parallel simulated annealing..." << std::endl;
-        auto startTime = std::chrono::high_resolution_clock::now();
-        
-        auto bestSolution = psa.run();
-        
-        auto endTime = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+        if (engine == "tempering") {
+            // Лестница температур от --t-min до initial_temperature, по реплике на поток
+            std::cout << "\n2. Configuring parallel tempering..." << std::endl;
+            ParallelTempering tempering(numThreads);
+            tempering.setInitialSolution(initialSolution);
+            tempering.setMutation(mutation);
+            tempering.setTemperatureRange(minTemperature > 0 ? minTemperature : initialTemperature / 1000, initialTemperature);
+            tempering.setIterationsPerTemperature(iterationsPerTemperature);
+            tempering.setMaxIterationsWithoutImprovement(iterationsWithoutImprovement);
+            tempering.setMaxSyncsWithoutImprovement(iterationsWithoutImprovementGlobal);
+            tempering.setSyncIterations(epochIterations);
+            tempering.setTargetSwapRate(swapRate);
+            tempering.setAdaptiveLadder(adaptiveLadder);
+            tempering.setSeed(RandomGenerator::deriveSeed(seed, 1));
+            
+            std::cout << "\n3. Running parallel tempering..." << std::endl;
+            auto startTime = std::chrono::high_resolution_clock::now();
+            bestSolution = tempering.run();
+            auto endTime = std::chrono::high_resolution_clock::now();
+            duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+            metrics = tempering.getMetrics();
+        } else {
+            std::cout << "\n2. Configuring parallel simulated annealing..." << std::endl;
+            coolingLaw->initialize(initialTemperature);
+            
+            ParallelSimulatedAnnealing psa(numThreads);
+            psa.setInitialSolution(initialSolution);
+            psa.setMutation(mutation);
+            psa.setCoolingLaw(coolingLaw);
+            psa.setInitialTemperature(initialTemperature);
+            psa.setIterationsPerTemperature(iterationsPerTemperature);
+            psa.setMaxIterationsWithoutImprovement(iterationsWithoutImprovement);
+            psa.setMaxIterationsWithoutImprovementGlobal(iterationsWithoutImprovementGlobal);
+            psa.setExchangeInterval(exchangeInterval);
+            psa.setSeed(RandomGenerator::deriveSeed(seed, 1));
+            psa.setEliteArchive(eliteSize, eliteDistance);
+            psa.setEpochIterations(epochIterations);
+            psa.setAsyncExchange(asyncExchange);
+            psa.setBatchProposals(batchSize, batchSelection);
+            psa.setRejectionFree(rejectionFreeSample, rejectionFreeThreshold);
+            psa.setStagnationStrategy(stagnationStrategy, maxRestarts, reheatFraction, kickMoves);
+            psa.setTimeLimit(timeLimitMilliseconds / 1000);
+            if (hasTarget) {
+                psa.setTargetFitness(targetFitness);
+            }
+            if (reportProgress) {
+                psa.setImprovementCallback([](const ParallelSimulatedAnnealing::Improvement& improvement) {
+                    std::cout << "Best so far: " << improvement.fitness << " at " << improvement.seconds * 1000
+                              << " ms (thread " << improvement.thread << ")" << std::endl;
+                });
+            }
+            psa.setInterruptFlag(&interruptRequested);
+            std::signal(SIGINT, handleInterrupt);
+            std::signal(SIGTERM, handleInterrupt);
+            if (!islandTopology.empty()) {
+                psa.setIslandModel(IslandModel::parseTopology(islandTopology), IslandModel::parsePolicy(migrationPolicy),
+                                   islandDegree, migrationInterval);
+            }
+            if (!metricsSamplesPath.empty()) {
+                psa.setMetricsSampling(metricsSamplesPath, metricsInterval);
+            }
+            
+            std::cout << "\n3. Running parallel simulated annealing..." << std::endl;
+            auto startTime = std::chrono::high_resolution_clock::now();
+            bestSolution = psa.run();
+            auto endTime = std::chrono::high_resolution_clock::now();
+            std::signal(SIGINT, SIG_DFL);
+            std::signal(SIGTERM, SIG_DFL);
+            duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+            metrics = psa.getMetrics();
+            if (interruptRequested) {
+                std::cout << "Interrupted, reporting the best solution found so far" << std::endl;
+            }
+        }
         
         std::cout << "Algorithm completed in " << duration.count() << " ms" << std::endl;
         
+        std::cout << "Iterations per second: " << metrics.iterationsPerSecond()
+                  << ", acceptance rate: " << metrics.total.acceptanceRate() << std::endl;
+        if (stagnationStrategy != SimulatedAnnealing::StagnationStrategy::Stop) {
+            std::cout << "Stagnation restarts: reheats " << metrics.total.reheats << ", elite restarts "
+                      << metrics.total.eliteRestarts << ", kicks " << metrics.total.kicks << std::endl;
+        }
+        if (!metricsPath.empty()) {
+            std::ofstream metricsFile(metricsPath);
+            if (!metricsFile.is_open()) {
+                throw std::runtime_error("Cannot open file: " + metricsPath);
+            }
+            metricsFile << metrics.toJson() << std::endl;
+        }
+        
         std::cout << "\n4. Results:" << std::endl;
         if (bestSolution) {
             auto scheduleSolution = std::dynamic_pointer_cast<ScheduleSolution>(bestSolution);
             if (scheduleSolution) {
-                double bestFitness = scheduleSolution->evaluate();
+                double bestFitness = scheduleSolution->fitness();
                 std::cout << "Best solution fitness: " << bestFitness << std::endl;
                 std::cout << "Improvement: " << (initialFitness - bestFitness) << std::endl;
                 std::cout << "Improvement percentage: " << ((initialFitness - bestFitness) / initialFitness * 100) << "%" << std::endl;
@@ -122,6 +665,7 @@ int main(int argc, char* argv[]) {
         }
         
         std::cout << "\n=== Parallel algorithm finished ===" << std::endl;
+        Logger::shutdown();
         return 0;
 
     } catch (const std::exception& e) {